@@ -0,0 +1,216 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/base/blockbzip2.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <magnet/exception.hpp>
+#include <boost/foreach.hpp>
+#include <bzlib.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace dynamo {
+  namespace blockbzip2 {
+    namespace {
+      //! \brief The data compressed into each stream, a multiple of
+      //! the 900k block size of bzip2.
+      const size_t streamSize = 4 * 900000;
+
+      struct CompressBlock
+      {
+	const char* data;
+	size_t size;
+	std::string out;
+
+	void run()
+	{
+	  //The worst case size of the compressed data, from the bzip2
+	  //documentation
+	  unsigned int outSize = size + size / 100 + 600;
+	  out.resize(outSize);
+
+	  int err = BZ2_bzBuffToBuffCompress(&out[0], &outSize, const_cast<char*>(data),
+					     size, 9, 0, 0);
+	  if (err != BZ_OK)
+	    M_throw() << "bzip2 compression failed with error " << err;
+
+	  out.resize(outSize);
+	}
+      };
+
+      /*! \brief Decompresses the concatenated bzip2 streams in data,
+	appending the result to out.
+
+	\param singleStream If true, data must hold exactly one stream.
+	\returns false if the data is not valid.
+       */
+      bool decompressStreams(const char* data, size_t size, std::string& out, bool singleStream)
+      {
+	char buffer[1 << 16];
+
+	do
+	  {
+	    bz_stream strm;
+	    std::memset(&strm, 0, sizeof(strm));
+	    if (BZ2_bzDecompressInit(&strm, 0, 0) != BZ_OK) return false;
+
+	    strm.next_in = const_cast<char*>(data);
+	    strm.avail_in = size;
+
+	    int err = BZ_OK;
+	    while (err == BZ_OK)
+	      {
+		strm.next_out = buffer;
+		strm.avail_out = sizeof(buffer);
+		err = BZ2_bzDecompress(&strm);
+		out.append(buffer, sizeof(buffer) - strm.avail_out);
+
+		//The input ran out before the end of the stream
+		if ((err == BZ_OK) && !strm.avail_in && strm.avail_out)
+		  err = BZ_UNEXPECTED_EOF;
+	      }
+
+	    const size_t used = size - strm.avail_in;
+	    BZ2_bzDecompressEnd(&strm);
+
+	    if (err != BZ_STREAM_END) return false;
+
+	    data += used;
+	    size -= used;
+	  }
+	while (size && !singleStream);
+
+	return !size;
+      }
+
+      struct DecompressBlock
+      {
+	const char* data;
+	size_t size;
+	std::string out;
+	bool valid;
+
+	void run() { valid = decompressStreams(data, size, out, true); }
+      };
+
+      /*! \brief Finds the offsets of the headers of the bzip2 streams
+	in the data.
+
+	A stream header is the "BZh" signature and block size digit,
+	followed by the magic number of a block or of the end of the
+	stream. The pattern can also appear inside compressed data, so
+	the offsets are only candidates.
+       */
+      std::vector<size_t> findStreams(const std::string& in)
+      {
+	static const char blockMagic[] = "\x31\x41\x59\x26\x53\x59";
+	static const char endMagic[] = "\x17\x72\x45\x38\x50\x90";
+
+	std::vector<size_t> starts;
+	for (size_t pos = in.find("BZh"); pos != std::string::npos; pos = in.find("BZh", pos + 1))
+	  if ((pos + 10 <= in.size()) && (in[pos + 3] >= '1') && (in[pos + 3] <= '9')
+	      && (!in.compare(pos + 4, 6, blockMagic, 6) || !in.compare(pos + 4, 6, endMagic, 6)))
+	    starts.push_back(pos);
+
+	return starts;
+      }
+    }
+
+    void
+    compress(const std::string& in, std::string& out, size_t threads)
+    {
+      //An empty input still needs one (empty) stream
+      std::vector<CompressBlock> blocks(std::max((in.size() + streamSize - 1) / streamSize, size_t(1)));
+
+      std::vector<magnet::function::Task*> tasks;
+      for (size_t i(0); i < blocks.size(); ++i)
+	{
+	  blocks[i].data = in.data() + i * streamSize;
+	  blocks[i].size = std::min(streamSize, in.size() - i * streamSize);
+	  tasks.push_back(magnet::function::Task::makeTask(&CompressBlock::run, &blocks[i]));
+	}
+
+      magnet::thread::ThreadPool pool;
+      pool.setThreadCount((threads > 1) ? std::min(threads, blocks.size()) : 0);
+      pool.queueTasks(tasks);
+      pool.wait();
+
+      size_t outSize = out.size();
+      BOOST_FOREACH(const CompressBlock& block, blocks)
+	outSize += block.out.size();
+      out.reserve(outSize);
+
+      BOOST_FOREACH(CompressBlock& block, blocks)
+	{
+	  out.append(block.out);
+	  std::string().swap(block.out);
+	}
+    }
+
+    void
+    decompress(const std::string& in, std::string& out, size_t threads)
+    {
+      std::vector<size_t> starts;
+      if (threads > 1) starts = findStreams(in);
+
+      if ((starts.size() > 1) && (starts.front() == 0))
+	{
+	  std::vector<DecompressBlock> blocks(starts.size());
+
+	  std::vector<magnet::function::Task*> tasks;
+	  for (size_t i(0); i < blocks.size(); ++i)
+	    {
+	      blocks[i].data = in.data() + starts[i];
+	      blocks[i].size = ((i + 1 < starts.size()) ? starts[i + 1] : in.size()) - starts[i];
+	      blocks[i].valid = false;
+	      tasks.push_back(magnet::function::Task::makeTask(&DecompressBlock::run, &blocks[i]));
+	    }
+
+	  magnet::thread::ThreadPool pool;
+	  pool.setThreadCount(std::min(threads, blocks.size()));
+	  pool.queueTasks(tasks);
+	  pool.wait();
+
+	  bool valid = true;
+	  size_t outSize = out.size();
+	  BOOST_FOREACH(const DecompressBlock& block, blocks)
+	    {
+	      valid = valid && block.valid;
+	      outSize += block.out.size();
+	    }
+
+	  //If a candidate stream header was actually inside the
+	  //compressed data, the blocks will have failed and the data
+	  //is decompressed serially below.
+	  if (valid)
+	    {
+	      out.reserve(outSize);
+	      BOOST_FOREACH(DecompressBlock& block, blocks)
+		{
+		  out.append(block.out);
+		  std::string().swap(block.out);
+		}
+	      return;
+	    }
+	}
+
+      if (!decompressStreams(in.data(), in.size(), out, false))
+	M_throw() << "Failed to decompress the bzip2 data, the file may be corrupt or truncated";
+    }
+  }
+}
@@ -0,0 +1,50 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <string>
+
+namespace dynamo {
+  /*! \brief Multi-threaded bzip2 compression and decompression.
+
+    The data is split into blocks which are compressed as independent
+    bzip2 streams and concatenated, in the same way as pbzip2. The
+    result is a valid bzip2 file, which bunzip2 and the boost
+    iostreams decompressor read as a single file.
+
+    As each stream can be decompressed independently, the files
+    written here are also decompressed in parallel. Files made of a
+    single stream (e.g., written by bzip2) are decompressed serially.
+   */
+  namespace blockbzip2 {
+    /*! \brief Compresses data into a multi-stream bzip2 file.
+
+      \param in The data to compress.
+      \param out The compressed data is appended to this string.
+      \param threads The number of threads to compress with.
+     */
+    void compress(const std::string& in, std::string& out, size_t threads);
+
+    /*! \brief Decompresses a (possibly multi-stream) bzip2 file.
+
+      \param in The compressed data.
+      \param out The decompressed data is appended to this string.
+      \param threads The number of threads to decompress with.
+     */
+    void decompress(const std::string& in, std::string& out, size_t threads);
+  }
+}
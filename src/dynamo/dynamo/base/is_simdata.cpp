@@ -16,6 +16,8 @@
 */
 
 #include <dynamo/base/is_simdata.hpp>
+#include <dynamo/base/snapshotwriter.hpp>
+#include <dynamo/base/blockbzip2.hpp>
 #include <dynamo/schedulers/scheduler.hpp>
 #include <dynamo/dynamics/liouvillean/liouvillean.hpp>
 #include <dynamo/schedulers/scheduler.hpp>
@@ -33,6 +35,33 @@
 //! The configuration file version, a version mismatch prevents an XML file load.
 const char configFileVersion[] = "1.4.0";
 
+namespace {
+  /*! \brief Returns the path of the binary particle data file which
+   * accompanies a configuration file, or an empty string if the
+   * particle data is to be written as XML.
+   *
+   * Configuration files with a name ending in ".bin.xml" or
+   * ".bin.xml.bz2" store their particle data in a binary file ending
+   * in ".bin.dat" alongside the configuration file.
+   */
+  std::string binaryDataFileName(std::string fileName)
+  {
+    if ((fileName.size() > 4) 
+	&& (std::string(fileName.end()-4, fileName.end()) == ".bz2"))
+      fileName.erase(fileName.size() - 4);
+
+    if ((fileName.size() > 4) 
+	&& (std::string(fileName.end()-4, fileName.end()) == ".xml"))
+      fileName.erase(fileName.size() - 4);
+
+    if ((fileName.size() > 4) 
+	&& (std::string(fileName.end()-4, fileName.end()) == ".bin"))
+      return fileName + ".dat";
+
+    return std::string();
+  }
+}
+
 namespace dynamo
 {
   SimData::SimData():
@@ -52,7 +81,8 @@ namespace dynamo
     lastRunMFT(0.0),
     simID(0),
     replexExchangeNumber(0),
-    status(START)
+    status(START),
+    ioThreads(1)
   {
   }
 
@@ -72,25 +102,20 @@ namespace dynamo
     if (!boost::filesystem::exists(fileName))
       M_throw() << "Could not find the XML file named " << fileName
 		<< "\nPlease check the file exists.";
-    { //This scopes out the file objects
-      
-      //We use the boost iostreams library to load the file into a
-      //string which may be compressed.
-      
-      //We make our filtering iostream
-      io::filtering_istream inputFile;
-      
-      //Now check if we should add a decompressor filter
-      if (std::string(fileName.end()-8, fileName.end()) == ".xml.bz2")
-	inputFile.push(io::bzip2_decompressor());
-      else if (!(std::string(fileName.end()-4, fileName.end()) == ".xml"))
-	M_throw() << "Unrecognized extension for xml file";
-
-      //Finally, add the file as a source
-      inputFile.push(io::file_source(fileName));
-	  
-      io::copy(inputFile, io::back_inserter(doc.getStoredXMLData()));
-    }
+    if (std::string(fileName.end()-8, fileName.end()) == ".xml.bz2")
+      {
+	//The compressed file is read whole and decompressed straight
+	//into the document, in parallel if it holds several streams
+	std::string compressed;
+	io::copy(io::file_source(fileName, std::ios::in | std::ios::binary), 
+		 io::back_inserter(compressed));
+	
+	blockbzip2::decompress(compressed, doc.getStoredXMLData(), ioThreads);
+      }
+    else if (std::string(fileName.end()-4, fileName.end()) == ".xml")
+      io::copy(io::file_source(fileName), io::back_inserter(doc.getStoredXMLData()));
+    else
+      M_throw() << "Unrecognized extension for xml file";
 
     doc.parseData();
 
@@ -123,7 +148,17 @@ namespace dynamo
     ptrScheduler 
       = std::tr1::shared_ptr<Scheduler>(Scheduler::getClass(subNode.getNode("Scheduler"), this));
 
-    dynamics.getLiouvillean().loadParticleXMLData(mainNode);
+    if (mainNode.getNode("ParticleData").hasAttribute("BinaryFile"))
+      {
+	//The binary file is stored relative to the configuration file
+	boost::filesystem::path dataFile 
+	  = boost::filesystem::path(fileName).parent_path() 
+	  / mainNode.getNode("ParticleData").getAttribute("BinaryFile").getValue();
+
+	dynamics.getLiouvillean().loadParticleBinaryData(mainNode, dataFile.string());
+      }
+    else
+      dynamics.getLiouvillean().loadParticleXMLData(mainNode);
   
     //Fixes or conversions once system is loaded
     lastRunMFT *= dynamics.units().unitTime();
@@ -147,14 +182,71 @@ namespace dynamo
       M_throw() << "Cannot write out configuration in this state";
   
     namespace io = boost::iostreams;
-    io::filtering_ostream coutputFile;
 
-    if (std::string(fileName.end()-4, fileName.end()) == ".bz2")
-      coutputFile.push(io::bzip2_compressor());
+    if ((ioThreads > 1) && (std::string(fileName.end()-4, fileName.end()) == ".bz2"))
+      {
+	std::string data;
+	{
+	  io::filtering_ostream coutputFile(io::back_inserter(data));
+	  writeXML(coutputFile, fileName, applyBC, round);
+	}
+
+	std::string compressed;
+	blockbzip2::compress(data, compressed, ioThreads);
+	std::string().swap(data);
+
+	io::file_sink outputFile(fileName, std::ios::out | std::ios::binary);
+	if (!outputFile.is_open())
+	  M_throw() << "Could not open " << fileName << " to write the configuration";
+	outputFile.write(compressed.data(), compressed.size());
+      }
+    else
+      {
+	io::filtering_ostream coutputFile;
+
+	if (std::string(fileName.end()-4, fileName.end()) == ".bz2")
+	  coutputFile.push(io::bzip2_compressor());
   
-    coutputFile.push(io::file_sink(fileName));
+	coutputFile.push(io::file_sink(fileName));
   
-    magnet::xml::XmlStream XML(coutputFile);
+	writeXML(coutputFile, fileName, applyBC, round);
+      }
+
+    dout << "Config written to " << fileName << std::endl;
+  }
+
+  void
+  SimData::writeXMLfileBackground(std::string fileName, bool applyBC)
+  {
+    if (status < INITIALISED || status == ERROR)
+      M_throw() << "Cannot write out configuration in this state";
+
+    std::tr1::shared_ptr<std::string> data(new std::string);
+
+    {
+      namespace io = boost::iostreams;
+      io::filtering_ostream coutputFile(io::back_inserter(*data));
+      writeXML(coutputFile, fileName, applyBC, false);
+    }
+
+    if (!_snapshotWriter)
+      _snapshotWriter.reset(new SnapshotWriter(ioThreads));
+
+    _snapshotWriter->queue(fileName, data);
+
+    dout << "Config queued for writing to " << fileName << std::endl;
+  }
+
+  void
+  SimData::flushBackgroundWrites()
+  {
+    if (_snapshotWriter) _snapshotWriter->flush();
+  }
+
+  void
+  SimData::writeXML(std::ostream& os, const std::string& fileName, bool applyBC, bool round)
+  {
+    magnet::xml::XmlStream XML(os);
     XML.setFormatXML(true);
 
     dynamics.getLiouvillean().updateAllParticles();
@@ -203,12 +295,14 @@ namespace dynamo
 	<< dynamics
 	<< _properties;
 
-    dynamics.getLiouvillean().outputParticleXMLData(XML, applyBC);
+    const std::string dataFile = binaryDataFileName(fileName);
+    if (dataFile.empty())
+      dynamics.getLiouvillean().outputParticleXMLData(XML, applyBC);
+    else
+      dynamics.getLiouvillean().outputParticleBinaryData(XML, applyBC, dataFile);
 
     XML << magnet::xml::endtag("DynamOconfig");
 
-    dout << "Config written to " << fileName << std::endl;
-
     //Rescale the properties back to the simulation units
     _properties.rescaleUnit(Property::Units::L, 
 			    dynamics.units().unitLength());
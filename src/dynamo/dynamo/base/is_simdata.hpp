@@ -37,6 +37,7 @@ namespace dynamo
   class Scheduler;
   class Particle;
   class OutputPlugin;
+  class SnapshotWriter;
 
   //! \brief Holds the different phases of the simulation initialisation
   typedef enum 
@@ -113,20 +114,38 @@ namespace dynamo
     //! Loads a Simulation from the passed XML file.
     //! \param filename The path to the XML file to load. The filename must
     //! end in either ".xml" for uncompressed xml files or ".bz2" for
-    //! bzip2 compressed configuration files.
+    //! bzip2 compressed configuration files. If the ParticleData tag
+    //! has a BinaryFile attribute, the particle data is memory mapped
+    //! from that file (relative to the directory of the XML file).
     void loadXMLfile(std::string filename);
     
     //! Writes the Simulation configuration to a file at the passed path.
     //! \param filename The path to the XML file to write (this file
     //! will either be created or overwritten). The filename must end in
     //! either ".xml" for uncompressed xml files or ".bz2" for bzip2
-    //! compressed configuration files.
+    //! compressed configuration files. If the name ends in
+    //! ".bin.xml" or ".bin.xml.bz2", the particle data is written to
+    //! a binary file ending in ".bin.dat" next to the XML file.
     //! \param round If true, the data in the XML file will be written
     //! out at 2 s.f. lower precision to round all the values. This is
     //! used in the test harness to remove rounding error ready for a
     //! comparison to a "correct" configuration file.
     void writeXMLfile(std::string filename, bool applyBC = true, bool round = false);
 
+    //! Writes the Simulation configuration to a file on a background
+    //! thread.
+    //!
+    //! The configuration is captured in memory before this returns, so
+    //! the simulation may continue while the file is compressed and
+    //! written. At most a few files are kept waiting to be written,
+    //! after which this blocks until the disk catches up.
+    //! \sa writeXMLfile for the arguments.
+    void writeXMLfileBackground(std::string filename, bool applyBC = true);
+
+    //! Blocks until all the files queued by writeXMLfileBackground are
+    //! written, and throws if any of them failed.
+    void flushBackgroundWrites();
+
     /*! \brief The Ensemble of the Simulation. */
     std::tr1::shared_ptr<Ensemble> ensemble;
 
@@ -165,7 +184,7 @@ namespace dynamo
     unsigned long N;
     
     /*! \brief The Particle's of the system. */
-    std::vector<Particle> particleList;  
+    ParticleStore particleList; 
     
     /*! \brief A log of the previous simulation history. */
     std::ostringstream ssHistory;
@@ -224,6 +243,15 @@ namespace dynamo
      */
     ESimulationStatus status;
 
+    /*! \brief The number of threads used to compress and decompress
+     * the configuration files.
+     *
+     * If this is greater than 1, bzip2 configuration files are
+     * written as multiple independent streams, which are compressed
+     * and decompressed in parallel.
+     */
+    size_t ioThreads;
+
     /*! \brief Register a callback for particle changes.*/
     void registerParticleUpdateFunc(const particleUpdateFunc& func) const
     { _particleUpdateNotify.push_back(func); }
@@ -241,6 +269,11 @@ namespace dynamo
     { return _particleRemovedFromSim; }
 
   private:    
+    //! Formats the configuration as written by writeXMLfile.
+    void writeXML(std::ostream&, const std::string& filename, bool applyBC, bool round);
+
+    std::tr1::shared_ptr<SnapshotWriter> _snapshotWriter;
+
     mutable std::vector<particleUpdateFunc> _particleUpdateNotify;
     mutable boost::signals2::signal<void (size_t)> _particleAddedToSim;
     mutable boost::signals2::signal<void (size_t)> _particleRemovedFromSim;
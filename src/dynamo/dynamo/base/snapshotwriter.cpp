@@ -0,0 +1,154 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/base/snapshotwriter.hpp>
+#include <dynamo/base/blockbzip2.hpp>
+#include <magnet/exception.hpp>
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <algorithm>
+#include <iostream>
+
+namespace dynamo {
+  SnapshotWriter::SnapshotWriter(size_t threads, size_t maxQueued):
+    _threads(threads),
+    _maxQueued(std::max(maxQueued, size_t(1))),
+    _pending(0),
+    _stop(false)
+  {
+    _thread.startTask(magnet::function::Task::makeTask(&SnapshotWriter::run, this));
+  }
+
+  SnapshotWriter::~SnapshotWriter()
+  {
+    {
+      magnet::thread::ScopedLock lock(_mutex);
+      _stop = true;
+      _jobQueued.notify_all();
+    }
+
+    //The worker thread finishes the queued jobs before it exits
+    _thread.join();
+
+    if (!_error.empty())
+      std::cerr << "SnapshotWriter: " << _error << std::endl;
+  }
+
+  void
+  SnapshotWriter::queue(const std::string& fileName,
+			const std::tr1::shared_ptr<const std::string>& data)
+  {
+    magnet::thread::ScopedLock lock(_mutex);
+    checkError();
+
+    while (_jobs.size() >= _maxQueued)
+      {
+	_jobDone.wait(_mutex);
+	checkError();
+      }
+
+    _jobs.push_back(Job(fileName, data));
+    ++_pending;
+    _jobQueued.notify_all();
+  }
+
+  void
+  SnapshotWriter::flush()
+  {
+    magnet::thread::ScopedLock lock(_mutex);
+
+    while (_pending)
+      _jobDone.wait(_mutex);
+
+    checkError();
+  }
+
+  void
+  SnapshotWriter::checkError()
+  {
+    if (_error.empty()) return;
+
+    std::string error;
+    std::swap(error, _error);
+    M_throw() << "Failed while writing a configuration in the background\n" << error;
+  }
+
+  void
+  SnapshotWriter::run()
+  {
+    magnet::thread::ScopedLock lock(_mutex);
+
+    for (;;)
+      {
+	while (_jobs.empty() && !_stop)
+	  _jobQueued.wait(_mutex);
+
+	if (_jobs.empty()) return;
+
+	Job job = _jobs.front();
+	_jobs.pop_front();
+
+	lock.unlock();
+
+	std::string error;
+	try {
+	  namespace io = boost::iostreams;
+	  io::filtering_ostream outputFile;
+
+	  const std::string& fileName = job.first;
+	  const bool compress = (fileName.size() > 4)
+	    && (std::string(fileName.end()-4, fileName.end()) == ".bz2");
+
+	  std::string compressed;
+	  if (compress && (_threads > 1))
+	    {
+	      blockbzip2::compress(*job.second, compressed, _threads);
+	      job.second.reset();
+	    }
+	  else if (compress)
+	    outputFile.push(io::bzip2_compressor());
+
+	  io::file_sink sink(fileName, std::ios::out | std::ios::binary);
+	  if (!sink.is_open())
+	    M_throw() << "Could not open the file";
+
+	  outputFile.push(sink);
+	  if (job.second)
+	    outputFile.write(job.second->data(), job.second->size());
+	  else
+	    outputFile.write(compressed.data(), compressed.size());
+	  if (!outputFile)
+	    M_throw() << "Failed while writing the data";
+	  outputFile.reset();
+	}
+	catch (std::exception& cxp)
+	  {
+	    error = std::string("Could not write ") + job.first + "\n" + cxp.what();
+	  }
+
+	//Release the data before reacquiring the lock
+	job.second.reset();
+
+	lock.lock();
+
+	if (!error.empty()) _error += error;
+	--_pending;
+	_jobDone.notify_all();
+      }
+  }
+}
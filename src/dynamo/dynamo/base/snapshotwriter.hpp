@@ -0,0 +1,96 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/thread/thread.hpp>
+#include <magnet/thread/mutex.hpp>
+#include <tr1/memory>
+#include <string>
+#include <deque>
+
+namespace dynamo {
+  /*! \brief Compresses and writes configuration files on a
+    background thread.
+
+    The configuration is formatted into memory by the caller, which
+    is quick compared to the bzip2 compression and the disk
+    access. The formatted data is then queued here and written out by
+    a single worker thread, so files are written in the order they are
+    queued.
+
+    The queue is bounded. If the disk cannot keep up, \ref queue
+    blocks until a slot is free, so the memory used by the pending
+    files stays bounded.
+   */
+  class SnapshotWriter
+  {
+  public:
+    /*! \param threads The number of threads used to compress each
+      file, see \ref blockbzip2.
+      \param maxQueued The maximum number of files waiting to be
+      written before \ref queue blocks.
+     */
+    SnapshotWriter(size_t threads = 1, size_t maxQueued = 2);
+
+    //! \brief Writes out any queued files and stops the worker thread.
+    ~SnapshotWriter();
+
+    /*! \brief Queues data to be written to a file.
+
+      If the filename ends in ".bz2" the data is bzip2 compressed.
+      Any error from writing a previous file is thrown here.
+     */
+    void queue(const std::string& fileName,
+	       const std::tr1::shared_ptr<const std::string>& data);
+
+    /*! \brief Blocks until all the queued files are written.
+
+      Any error from writing a previous file is thrown here.
+     */
+    void flush();
+
+  protected:
+    SnapshotWriter(const SnapshotWriter&);
+    SnapshotWriter& operator=(const SnapshotWriter&);
+
+    //! \brief The loop of the worker thread.
+    void run();
+
+    //! \brief Throws any error left by the worker thread.
+    void checkError();
+
+    typedef std::pair<std::string, std::tr1::shared_ptr<const std::string> > Job;
+
+    const size_t _threads;
+    const size_t _maxQueued;
+
+    //! \brief Protects all the following members.
+    magnet::thread::Mutex _mutex;
+    //! \brief Signalled when a job is queued or the writer is stopped.
+    magnet::thread::Condition _jobQueued;
+    //! \brief Signalled when a job is completed.
+    magnet::thread::Condition _jobDone;
+
+    std::deque<Job> _jobs;
+    //! \brief The number of jobs queued or being written.
+    size_t _pending;
+    bool _stop;
+    std::string _error;
+
+    magnet::thread::Thread _thread;
+  };
+}
@@ -19,10 +19,12 @@
 #include <dynamo/inputplugins/compression.hpp>
 #include <dynamo/dynamics/systems/tHalt.hpp>
 #include <dynamo/dynamics/systems/schedMaintainer.hpp>
+#include <dynamo/dynamics/systems/mortonReorder.hpp>
 #include <dynamo/outputplugins/0partproperty/misc.hpp>
 #include <dynamo/outputplugins/general/reverseEvents.hpp>
 #include <dynamo/dynamics/systems/visualizer.hpp>
 #include <dynamo/dynamics/systems/snapshot.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
 #include <limits>
 
 
@@ -54,7 +56,23 @@ namespace dynamo {
       ("scheduler-maintainance,m", boost::program_options::value<double>(),
        "Rebuild the scheduler periodically, for systems where we've not built "
        "the scheduler correctly")
+      ("scheduler-threads", boost::program_options::value<size_t>(),
+       "Number of threads used to predict the events when the scheduler "
+       "rebuilds its event list (at startup, after replica exchanges and "
+       "rescales). These threads also run the ticker plugins which only "
+       "read the simulation concurrently.")
+      ("scheduler-prune", boost::program_options::value<double>(),
+       "Compact the particle event lists when more than this fraction of "
+       "the interaction events reaching the top of the queue are stale")
+      ("morton-reorder", boost::program_options::value<double>(),
+       "Periodically sort the particle data in memory into the Morton order "
+       "of the neighbour list cells, to keep neighbouring particles close in "
+       "memory. Sets the time between sorts.")
       ("unwrapped", "Don't apply the boundary conditions of the system when writing out the particle positions.")
+      ("io-threads", boost::program_options::value<size_t>(),
+       "Number of threads used to compress and decompress the configuration "
+       "files. With more than one thread, configurations are written as "
+       "multi-stream bzip2 files so they can also be loaded in parallel.")
       ("snapshot", boost::program_options::value<double>(),
        "Sets the system time inbetween saving snapshots of the system.")
       ;
@@ -89,10 +107,19 @@ namespace dynamo {
     if (vm.count("random-seed"))
       Sim.setRandSeed(vm["random-seed"].as<unsigned int>());
   
+    if (vm.count("io-threads"))
+      Sim.ioThreads = vm["io-threads"].as<size_t>();
+
     ////////////////////////Simulation Initialisation!!!!!!!!!!!!!
     //Now load the config
     Sim.loadXMLfile(filename.c_str());
     Sim.setTrajectoryLength(vm["ncoll"].as<unsigned long long>());
+
+    if (vm.count("scheduler-threads"))
+      Sim.ptrScheduler->setThreadCount(vm["scheduler-threads"].as<size_t>());
+
+    if (vm.count("scheduler-prune"))
+      Sim.ptrScheduler->setPruneThreshold(vm["scheduler-prune"].as<double>());
   
     if (vm["ncoll"].as<unsigned long long>() 
 	> vm["print-coll"].as<unsigned long long>())
@@ -106,6 +133,9 @@ namespace dynamo {
     if (vm.count("scheduler-maintainance"))
       Sim.addSystem(new CSSchedMaintainer(&Sim, vm["scheduler-maintainance"].as<double>(), "SchedulerRebuilder"));
 
+    if (vm.count("morton-reorder"))
+      Sim.addSystem(new SMortonReorder(&Sim, vm["morton-reorder"].as<double>(), "MortonReorder"));
+
 #ifdef DYNAMO_visualizer
     if (vm.count("visualizer"))
       Sim.addSystem(new SVisualizer(&Sim, filename, vm["visualizer"].as<double>()));
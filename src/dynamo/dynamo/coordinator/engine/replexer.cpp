@@ -26,8 +26,14 @@
 #include <boost/random/uniform_int.hpp>
 #include <fstream>
 #include <limits>
+#include <algorithm>
 
 namespace dynamo {
+  namespace {
+    double seconds(const boost::posix_time::time_duration& dt)
+    { return dt.total_microseconds() * 1e-6; }
+  }
+
   void
   EReplicaExchangeSimulation::getOptions(boost::program_options::options_description& opts)
   {
@@ -51,7 +57,9 @@ namespace dynamo {
        "  1: \tAlternating sets of pairs (~Nsims/2 attempts per swap event)\n"
        "  2: \tRandom pair per swap\n"
        "  3: \t5 * Nsim random pairs per swap\n"
-       "  4: \tRandom selection of the above methods")
+       "  4: \tRandom selection of the above methods\n"
+       "  5: \tAlternating sets of pairs, each pair swapping as soon as both"
+       " systems reach the exchange interval")
       ;
   
     opts.add(ropts);
@@ -161,6 +169,18 @@ namespace dynamo {
 
   void 
   EReplicaExchangeSimulation::outputData()
+  {
+    outputReplexStats();
+  
+    int i = 0;
+  
+    BOOST_FOREACH(replexPair p1, temperatureList)
+      Simulations[p1.second.simID].outputData
+      ((magnet::string::search_replace(outputFormat, "%ID", boost::lexical_cast<std::string>(i++))).c_str());
+  }
+
+  void
+  EReplicaExchangeSimulation::outputReplexStats()
   {
     {
       std::fstream replexof("replex.dat",std::ios::out | std::ios::trunc);
@@ -184,15 +204,19 @@ namespace dynamo {
 	       << "\nTime_spent_replexing " <<  boost::posix_time::to_simple_string(end_Time - start_Time)
 	       << "\nReplex Rate " << static_cast<double>(replexSwapCalls) / static_cast<double>((end_Time - start_Time).total_seconds())
 	       << "\n";	
+
+      //The wall time each temperature spent running and waiting
+      //for the other temperatures
+      BOOST_FOREACH(const replexPair& myPair, temperatureList)
+	replexof << "Replica_time " << myPair.second.realTemperature << " "
+		 << myPair.second.runTime << " " 
+		 << myPair.second.idleTime << " "
+		 << myPair.second.idleTime 
+	  / (myPair.second.runTime + myPair.second.idleTime)
+		 << "\n";
     
       replexof.close();
     }    
-  
-    int i = 0;
-  
-    BOOST_FOREACH(replexPair p1, temperatureList)
-      Simulations[p1.second.simID].outputData
-      ((magnet::string::search_replace(outputFormat, "%ID", boost::lexical_cast<std::string>(i++))).c_str());
   }
 
   void
@@ -222,6 +246,13 @@ namespace dynamo {
   
     Simulations.reset(new Simulation[nSims]);
 
+    if (ReplexMode == AsynchronousSequence)
+      {
+	asyncRounds.resize(nSims, 0);
+	asyncPairWaiting.resize(nSims, -1);
+	asyncPairMutex.reset(new magnet::thread::Mutex[nSims]);
+      }
+
     //We set this straight away
     for (size_t id(0); id < nSims; ++id)
       Simulations[id].simID = id;
@@ -260,7 +291,7 @@ namespace dynamo {
   { 
     std::cout << "Replica Exchange, ReplexSwap No." << replexSwapCalls 
 	      << ", Round Trips " << round_trips
-	      << "\n        T   ID     NColl   A-Ratio     Swaps    UpSims     DownSims\n";
+	      << "\n        T   ID     NColl   A-Ratio     Swaps    UpSims     DownSims     Idle\n";
   
 
     size_t outputCount(0);
@@ -285,6 +316,8 @@ namespace dynamo {
 		  << dat.second.downSims
 		  << " "
 		  << (SimDirection[dat.second.simID] < 0 ? "\\/" : "  ")
+		  << " " << std::setw(8)
+		  << dat.second.idleTime / (dat.second.runTime + dat.second.idleTime)
 		  << "\n";
 	if (++outputCount > 30)
 	  {
@@ -306,6 +339,8 @@ namespace dynamo {
       {
       case NoSwapping:
 	break;
+      case AsynchronousSequence:
+	M_throw() << "Asynchronous exchanges are attempted as the simulations run";
       case SinglePair:
 	{
 	  if (temperatureList.size() == 2)
@@ -434,6 +469,173 @@ namespace dynamo {
       }
   }
 
+  void 
+  EReplicaExchangeSimulation::resetReplexHalt(Simulation& sim)
+  {
+    //Reset the stop event
+    CStHalt* tmpRef = dynamic_cast<CStHalt*>(sim.getSystem("ReplexHalt"));
+		      
+#ifdef DYNAMO_DEBUG
+    if (tmpRef == NULL)
+      M_throw() << "Could not find the time halt event error";
+#endif			
+    //Each simulations exchange time is inversly proportional to its temperature
+    double tFactor 
+      = std::sqrt(temperatureList.begin()->second.realTemperature
+		  / sim.getEnsemble()->getReducedEnsembleVals()[2]); 
+
+    tmpRef->increasedt(vm["replex-interval"].as<double>() * tFactor);
+
+    sim.ptrScheduler->rebuildSystemEvents();
+
+    //Reset the max collisions
+    sim.setTrajectoryLength(vm["ncoll"].as<unsigned long long>());
+  }
+
+  void 
+  EReplicaExchangeSimulation::runReplica(const size_t tempID)
+  {
+    simData& dat = temperatureList[tempID].second;
+
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    Simulations[dat.simID].runSimulation(true);
+    dat.arrivalTime = boost::posix_time::microsec_clock::universal_time();
+    dat.runTime += seconds(dat.arrivalTime - start);
+  }
+
+  void 
+  EReplicaExchangeSimulation::runAsyncReplica(const size_t tempID)
+  {
+    runReplica(tempID);
+
+    //Find this interval's exchange partner
+    const size_t partner = ((tempID + asyncRounds[tempID]) % 2) ? tempID - 1 : tempID + 1;
+
+    if (partner >= nSims)
+      {
+	//The coldest or hottest temperature has no partner this interval
+	if (asyncIntervalComplete(tempID))
+	  threads.queueTask(magnet::function::Task::makeTask
+			    (&EReplicaExchangeSimulation::runAsyncReplica, this, tempID));
+	return;
+      }
+
+    const size_t pairID = std::min(tempID, partner);
+    {
+      magnet::thread::ScopedLock lock(asyncPairMutex[pairID]);
+
+      if (asyncPairWaiting[pairID] < 0)
+	{
+	  //The partner is still running, it will attempt the exchange
+	  asyncPairWaiting[pairID] = tempID;
+	  return;
+	}
+      
+      asyncPairWaiting[pairID] = -1;
+    }
+    
+    //Both Simulations of the pair are halted and only this thread
+    //can access them
+    simData& partnerData = temperatureList[partner].second;
+    partnerData.idleTime += seconds(boost::posix_time::microsec_clock::universal_time() 
+				    - partnerData.arrivalTime);
+
+    AttemptSwap(pairID, pairID + 1);
+
+    if (asyncIntervalComplete(tempID))
+      threads.queueTask(magnet::function::Task::makeTask
+			(&EReplicaExchangeSimulation::runAsyncReplica, this, tempID));
+
+    if (asyncIntervalComplete(partner))
+      threads.queueTask(magnet::function::Task::makeTask
+			(&EReplicaExchangeSimulation::runAsyncReplica, this, partner));
+  }
+
+  bool
+  EReplicaExchangeSimulation::asyncIntervalComplete(const size_t tempID)
+  {
+    simData& dat = temperatureList[tempID].second;
+    Simulation& sim = Simulations[dat.simID];
+
+    ++asyncRounds[tempID];
+    ++(sim.replexExchangeNumber);
+
+    if (SimDirection[dat.simID] > 0)
+      ++dat.upSims;
+    else if (SimDirection[dat.simID] < 0)
+      ++dat.downSims;
+
+    if ((tempID == 0) && (SimDirection[dat.simID] == -1))
+      {
+	if (roundtrip[dat.simID])
+	  {
+	    magnet::thread::ScopedLock lock(asyncStatsMutex);
+	    ++round_trips;
+	  }
+
+	roundtrip[dat.simID] = true;
+      }
+
+    if ((tempID == nSims - 1) && (SimDirection[dat.simID] == 1))
+      {
+	if (roundtrip[dat.simID])
+	  {
+	    magnet::thread::ScopedLock lock(asyncStatsMutex);
+	    ++round_trips;
+	  }
+
+	roundtrip[dat.simID] = true;
+      }
+
+    if (tempID == 0)
+      SimDirection[dat.simID] = 1; //Going up
+
+    if (tempID == nSims - 1)
+      SimDirection[dat.simID] = -1; //Going down
+
+    resetReplexHalt(sim);
+
+    //Each temperature stops after the same number of intervals as
+    //the coldest temperature takes to reach the end time
+    double tFactor 
+      = std::sqrt(temperatureList.begin()->second.realTemperature
+		  / sim.getEnsemble()->getReducedEnsembleVals()[2]); 
+
+    return !peekMode
+      && (sim.getSysTime() < replicaEndTime * tFactor)
+      && (sim.getnColl() < vm["ncoll"].as<unsigned long long>());
+  }
+
+  void 
+  EReplicaExchangeSimulation::runAsynchronous()
+  {
+    //Start every temperature which is not waiting on its partner
+    std::vector<magnet::function::Task*> tasks;
+    for (size_t tempID(0); tempID < nSims; ++tempID)
+      {
+	const size_t partner = ((tempID + asyncRounds[tempID]) % 2) ? tempID - 1 : tempID + 1;
+	
+	if ((partner < nSims) 
+	    && (asyncPairWaiting[std::min(tempID, partner)] == int(tempID)))
+	  continue;
+
+	const Simulation& sim = Simulations[temperatureList[tempID].second.simID];
+	double tFactor 
+	  = std::sqrt(temperatureList.begin()->second.realTemperature
+		      / sim.getEnsemble()->getReducedEnsembleVals()[2]); 
+
+	if ((sim.getSysTime() < replicaEndTime * tFactor)
+	    && (sim.getnColl() < vm["ncoll"].as<unsigned long long>()))
+	  tasks.push_back(magnet::function::Task::makeTask
+			  (&EReplicaExchangeSimulation::runAsyncReplica, this, tempID));
+      }
+
+    threads.queueTasks(tasks);
+    threads.wait();
+
+    replexSwapCalls = *std::min_element(asyncRounds.begin(), asyncRounds.end());
+  }
+
   void EReplicaExchangeSimulation::runSimulation()
   {
     start_Time = boost::posix_time::second_clock::local_time();
@@ -454,32 +656,14 @@ namespace dynamo {
 		  
 	    peekMode = false;
 		  
-	    {
-	      std::fstream replexof("replex.dat",std::ios::out | std::ios::trunc);
-		    
-	      BOOST_FOREACH(const replexPair& myPair, temperatureList)
-		replexof << myPair.second.realTemperature << " " 
-			 << myPair.second.swaps << " " 
-			 << (static_cast<double>(myPair.second.swaps) 
-			     / static_cast<double>(myPair.second.attempts))  << " "
-			 << myPair.second.upSims << " "
-			 << myPair.second.downSims
-			 << "\n";
-		    
-	      replexof.close();      
-	    }
-		  
-	    {      
-	      std::fstream replexof("replex.stats", std::ios::out | std::ios::trunc);
-		    
-	      replexof << "Number_of_replex_cycles " << replexSwapCalls
-		       << "\nTime_spent_replexing " <<  boost::posix_time::to_simple_string(end_Time - start_Time)
-		       << "\nReplex Rate " << static_cast<double>(replexSwapCalls) / static_cast<double>((end_Time - start_Time).total_seconds())
-		       << "\n";	
-		    
-	      replexof.close();
-	    }
-		  
+	    outputReplexStats();
+	  }
+	else if (ReplexMode == AsynchronousSequence)
+	  {
+	    runAsynchronous();
+
+	    //The simulations only stop early to peek at the data
+	    if (!peekMode) break;
 	  }
 	else 
 	  {
@@ -488,11 +672,16 @@ namespace dynamo {
 	    std::vector<magnet::function::Task*> tasks(nSims, NULL);
 	  
 	    for (size_t i(0); i < nSims; ++i)
-	      tasks[i] = magnet::function::Task::makeTask(&Simulation::runSimulation, 
-							  &(Simulations[i]), true);
+	      tasks[i] = magnet::function::Task::makeTask(&EReplicaExchangeSimulation::runReplica, 
+							  this, i);
 
 	    threads.queueTasks(tasks);
 	    threads.wait();//This syncs the systems for the replica exchange
+
+	    //Record the time each temperature waited for the slowest
+	    boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+	    BOOST_FOREACH(replexPair& dat, temperatureList)
+	      dat.second.idleTime += seconds(now - dat.second.arrivalTime);
 		  
 	    //Swap calculation
 	    ReplexSwap(ReplexMode);
@@ -501,27 +690,7 @@ namespace dynamo {
 		  
 	    //Reset the stop events
 	    for (size_t i = nSims; i != 0;)
-	      {
-		//Reset the stop event
-		CStHalt* tmpRef = dynamic_cast<CStHalt*>
-		  (Simulations[--i].getSystem("ReplexHalt"));
-		      
-#ifdef DYNAMO_DEBUG
-		if (tmpRef == NULL)
-		  M_throw() << "Could not find the time halt event error";
-#endif			
-		//Each simulations exchange time is inversly proportional to its temperature
-		double tFactor 
-		  = std::sqrt(temperatureList.begin()->second.realTemperature
-			      / Simulations[i].getEnsemble()->getReducedEnsembleVals()[2]); 
-
-		tmpRef->increasedt(vm["replex-interval"].as<double>() * tFactor);
-
-		Simulations[i].ptrScheduler->rebuildSystemEvents();
-
-		//Reset the max collisions
-		Simulations[i].setTrajectoryLength(vm["ncoll"].as<unsigned long long>());
-	      }
+	      resetReplexHalt(Simulations[--i]);
 	  }
       }
     end_Time = boost::posix_time::second_clock::local_time();
@@ -536,6 +705,7 @@ namespace dynamo {
     BOOST_FOREACH(replexPair p1, temperatureList)
       {
 	TtoID << p1.second.realTemperature << " " << i << "\n";
+	Simulations[p1.second.simID].flushBackgroundWrites();
 	Simulations[p1.second.simID].setTrajectoryLength(vm["ncoll"].as<unsigned long long>());
 	Simulations[p1.second.simID].writeXMLfile(magnet::string::search_replace(configFormat, "%ID", boost::lexical_cast<std::string>(i++)), 
 						  !vm.count("unwrapped"));
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <dynamo/coordinator/engine/engine.hpp>
+#include <magnet/thread/mutex.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 namespace dynamo {
@@ -111,8 +112,12 @@ namespace dynamo {
 			neighbour*/
       RandomPairs = 3, /*!< For 5*No. of Simulations, pick two random
 			 Simulations and attempt to swap them*/
-      RandomSelection = 4 /*!< Pick randomly between RandomPairs and
+      RandomSelection = 4, /*!< Pick randomly between RandomPairs and
 			    AlternatingSequence.*/
+      AsynchronousSequence = 5 /*!< Attempt to swap neighbouring pairs
+				 as soon as both have finished their
+				 interval, without waiting for the
+				 other Simulations.*/
     } Replex_Mode_Type;
 
     /*! \brief A structure to hold replica exchange data on a single
@@ -127,7 +132,7 @@ namespace dynamo {
        */
       explicit simData(int ID, double rT):
 	simID(ID), swaps(0), attempts(0), upSims(0), downSims(0),
-	realTemperature(rT)
+	realTemperature(rT), runTime(0), idleTime(0)
       {}
 
       /*! \brief compares simData by their contained simulation ID's
@@ -152,6 +157,15 @@ namespace dynamo {
       size_t downSims;
       /*! \brief The temperature of this simulation point */
       double realTemperature;
+      /*! \brief The wall time (in seconds) spent running the
+        Simulation's at this temperature. */
+      double runTime;
+      /*! \brief The wall time (in seconds) this temperature spent
+        waiting for other temperatures before a replica exchange. */
+      double idleTime;
+      /*! \brief The wall time this temperature last finished an
+        exchange interval. */
+      boost::posix_time::ptime arrivalTime;
     };
 
     typedef std::pair<double, simData> replexPair;
@@ -215,6 +229,26 @@ namespace dynamo {
      */
     bool peekMode;
 
+    /*! \brief The number of exchange intervals each temperature has
+     * completed in the AsynchronousSequence mode.
+     */
+    std::vector<size_t> asyncRounds;
+
+    /*! \brief For each neighbouring pair of temperatures, the index
+     * of the temperature waiting for the other to finish its
+     * interval, or -1 if neither is waiting.
+     */
+    std::vector<int> asyncPairWaiting;
+
+    /*! \brief A lock for each entry of \ref asyncPairWaiting.
+     */
+    boost::scoped_array<magnet::thread::Mutex> asyncPairMutex;
+
+    /*! \brief A lock for the statistics shared between the coldest
+     * and hottest temperatures in the AsynchronousSequence mode.
+     */
+    magnet::thread::Mutex asyncStatsMutex;
+
     /*! \brief Initialises this class ready for the replica exchange.
      */
     virtual void preSimInit();
@@ -251,6 +285,47 @@ namespace dynamo {
      */
     void ReplexSwapTicker();
 
+    /*! \brief Run the Simulation at a temperature until its next
+     * exchange interval ends, recording the time taken.
+     *
+     * \param tempID The index of the temperature in the \ref
+     * temperatureList.
+     */
+    void runReplica(const size_t tempID);
+
+    /*! \brief Run the Simulations in the AsynchronousSequence mode
+     * until they have all finished or a peek is requested.
+     *
+     * Every temperature runs as its own task. The temperature
+     * pairs alternate between (2i, 2i+1) and (2i+1, 2i+2) with every
+     * exchange interval, and a pair attempts an exchange as soon as
+     * both temperatures have finished their interval.
+     */
+    void runAsynchronous();
+
+    /*! \brief The task run for each temperature in the
+     * AsynchronousSequence mode.
+     */
+    void runAsyncReplica(const size_t tempID);
+
+    /*! \brief Update the replica exchange data of a temperature
+     * which has completed an interval in the AsynchronousSequence
+     * mode, and schedule its next interval.
+     *
+     * \returns If the temperature should run another interval.
+     */
+    bool asyncIntervalComplete(const size_t tempID);
+
+    /*! \brief Set the ReplexHalt of a Simulation to the end of its
+     * next exchange interval.
+     */
+    void resetReplexHalt(Simulation&);
+
+    /*! \brief Output the replica exchange statistics to the
+     * replex.dat and replex.stats files.
+     */
+    void outputReplexStats();
+
     /*! \brief Attempt a replica exchange move between two configurations.
      *
      * \param id1 First Simulation to attempt to exchange.
@@ -90,6 +90,7 @@ namespace dynamo {
   void
   ESingleSimulation::outputConfigs()
   {
+    simulation.flushBackgroundWrites();
     simulation.writeXMLfile(configFormat.c_str(), !vm.count("unwrapped"));
   }
 
@@ -18,9 +18,15 @@
 #pragma once
 
 #include <dynamo/dynamics/2particleEventData.hpp>
-#include <list>
+#include <magnet/containers/small_vector.hpp>
 
 namespace dynamo {
+  /*! \brief The changes made to the particles by an event.
+
+    Most events change one particle or one pair of particles, so the
+    changes are kept in SmallVector's which only allocate memory for
+    larger events (e.g., multibody events or rescales).
+   */
   class NEventData
   {
   public:
@@ -31,7 +37,7 @@ namespace dynamo {
     NEventData&  operator+=(const ParticleEventData& p) { L1partChanges.push_back(p); return *this; }
     NEventData&  operator+=(const PairEventData& p) { L2partChanges.push_back(p); return *this; }
 
-    std::list<ParticleEventData> L1partChanges;
-    std::list<PairEventData> L2partChanges;
+    magnet::containers::SmallVector<ParticleEventData, 2> L1partChanges;
+    magnet::containers::SmallVector<PairEventData, 1> L2partChanges;
   };
 }
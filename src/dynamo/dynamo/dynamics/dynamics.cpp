@@ -17,6 +17,8 @@
 
 #include <dynamo/dynamics/dynamics.hpp>
 #include <dynamo/dynamics/include.hpp>
+#include <dynamo/dynamics/interactions/captures.hpp>
+#include <dynamo/dynamics/globals/neighbourList.hpp>
 #include <dynamo/base/is_simdata.hpp>
 #include <dynamo/dynamics/NparticleEventData.hpp>
 #include <dynamo/dynamics/systems/sysTicker.hpp>
@@ -26,6 +28,7 @@
 #include <magnet/xmlwriter.hpp>
 #include <boost/foreach.hpp>
 #include <cmath>
+#include <algorithm>
 
 namespace dynamo {
 
@@ -62,6 +65,9 @@ namespace dynamo {
   const Species& 
   Dynamics::getSpecies(const Particle& p1) const 
   {
+    if (!_interactionLookup.empty())
+      return *species[getSpeciesIndex(p1)];
+
     BOOST_FOREACH(const std::tr1::shared_ptr<Species>& ptr, species)
       if (ptr->isSpecies(p1))
 	return *ptr;
@@ -310,6 +316,8 @@ namespace dynamo {
     BOOST_FOREACH(std::tr1::shared_ptr<Interaction>& ptr, interactions)
       ptr->initialise(ID++);
 
+    buildInteractionLookup();
+
     ID=0;
 
     //Must be initialised before globals. Neighbour lists are
@@ -322,15 +330,78 @@ namespace dynamo {
     BOOST_FOREACH(std::tr1::shared_ptr<Global>& ptr, globals)
       ptr->initialise(ID++);
 
+    //The capture maps are built once the neighbour lists are
+    //initialised, as these are used to find the captured pairs
+    BOOST_FOREACH(std::tr1::shared_ptr<Interaction>& ptr, interactions)
+      if (ICapture* capture = dynamic_cast<ICapture*>(ptr.get()))
+	capture->initCaptureMap(Sim, ptr->maxIntDist());
+
     ID=0;
 
     BOOST_FOREACH(std::tr1::shared_ptr<System>& ptr, systems)
       ptr->initialise(ID++);
   }
 
+  void
+  Dynamics::buildInteractionLookup()
+  {
+    _particleSpecies.clear();
+    _interactionLookup.clear();
+
+    if (species.size() > 1)
+      {
+	_particleSpecies.resize(Sim->N);
+	for (size_t s(0); s < species.size(); ++s)
+	  BOOST_FOREACH(unsigned long ID, *species[s]->getRange())
+	    _particleSpecies[ID] = s;
+      }
+
+    _interactionLookup.resize(species.size() * species.size());
+
+    for (size_t s1(0); s1 < species.size(); ++s1)
+      for (size_t s2(0); s2 < species.size(); ++s2)
+	{
+	  InteractionLookup& entry = _interactionLookup[s1 * species.size() + s2];
+
+	  for (size_t i(0); i < interactions.size(); ++i)
+	    {
+	      C2Range::Coverage coverage 
+		= interactions[i]->getRange()->getCoverage(*species[s1]->getRange(), 
+							   *species[s2]->getRange(), Sim);
+
+	      if (coverage == C2Range::NONE) continue;
+
+	      entry.candidates.push_back(i);
+
+	      if (coverage == C2Range::ALL)
+		{
+		  entry.certain = true;
+		  break;
+		}
+	    }
+	}
+  }
+
   const std::tr1::shared_ptr<Interaction>&
   Dynamics::getInteraction(const Particle& p1, const Particle& p2) const 
   {
+    if (!_interactionLookup.empty())
+      {
+	const InteractionLookup& entry 
+	  = _interactionLookup[getSpeciesIndex(p1) * species.size() + getSpeciesIndex(p2)];
+
+	const size_t uncertain = entry.candidates.size() - entry.certain;
+	for (size_t i(0); i < uncertain; ++i)
+	  if (interactions[entry.candidates[i]]->isInteraction(p1,p2))
+	    return interactions[entry.candidates[i]];
+
+	if (entry.certain)
+	  return interactions[entry.candidates.back()];
+
+	M_throw() << "Could not find the interaction requested"
+		  << "\nID1 = " << p1.getID() << ", ID2 = " << p2.getID();
+      }
+
     BOOST_FOREACH(const std::tr1::shared_ptr<Interaction>& ptr, interactions)
       if (ptr->isInteraction(p1,p2))
 	return ptr;
@@ -570,16 +641,147 @@ namespace dynamo {
   }
 
 
+  const GNeighbourList* 
+  Dynamics::getNeighbourList(double maxDist) const
+  {
+    BOOST_FOREACH(const std::tr1::shared_ptr<Global>& glob, globals)
+      {
+	const GNeighbourList* nblist 
+	  = dynamic_cast<const GNeighbourList*>(glob.get());
+	
+	if (!nblist || (nblist->getMaxSupportedInteractionLength() < maxDist))
+	  continue;
+	
+	bool allParticles = true;
+	BOOST_FOREACH(const Particle& part, Sim->particleList)
+	  if (!nblist->isInteraction(part))
+	    { allParticles = false; break; }
+	
+	if (allParticles) return nblist;
+      }
+    
+    return NULL;
+  }
+
+  namespace {
+    /*! \brief A block of particles to be tested by
+     * Dynamics::SystemOverlapTest.
+     *
+     * The block tests the pairs (i, j) with i in [start, end) and j >
+     * i, using the neighbour list if one is given, and collects the
+     * pairs in an invalid state.
+     */
+    struct OverlapBlock
+    {
+      OverlapBlock(const SimData* Sim_in, const GNeighbourList* nblist_in, 
+		   size_t start_in, size_t end_in):
+	Sim(Sim_in), nblist(nblist_in), start(start_in), end(end_in)
+      {}
+
+      void run()
+      {
+	for (size_t ID(start); ID < end; ++ID)
+	  if (nblist)
+	    nblist->getParticleNeighbourhood
+	      (Sim->particleList[ID], magnet::function::MakeDelegate(this, &OverlapBlock::test));
+	  else
+	    for (size_t ID2(ID + 1); ID2 < Sim->N; ++ID2)
+	      test(Sim->particleList[ID], ID2);
+      }
+
+      void test(const Particle& p1, const size_t& ID2)
+      {
+	if (ID2 <= p1.getID()) return;
+
+	const Particle& p2 = Sim->particleList[ID2];
+	if (Sim->dynamics.getInteraction(p1, p2)->checkOverlaps(p1, p2, false))
+	  pairs.push_back(std::make_pair(p1.getID(), ID2));
+      }
+
+      const SimData* Sim;
+      const GNeighbourList* nblist;
+      size_t start;
+      size_t end;
+      std::vector<std::pair<size_t, size_t> > pairs;
+    };
+  }
+
   void 
   Dynamics::SystemOverlapTest()
   {
+    typedef std::pair<size_t, size_t> IDPair;
+
     p_liouvillean->updateAllParticles();
 
-    std::vector<Particle>::const_iterator iPtr1, iPtr2;
-  
-    for (iPtr1 = Sim->particleList.begin(); iPtr1 != Sim->particleList.end(); ++iPtr1)
-      for (iPtr2 = iPtr1 + 1; iPtr2 != Sim->particleList.end(); ++iPtr2)    
-	getInteraction(*iPtr1, *iPtr2)->checkOverlaps(*iPtr1, *iPtr2);
+    //The pairs can only be found through a neighbour list if every
+    //invalid state is between nearby or captured pairs
+    const GNeighbourList* nblist = NULL;
+    {
+      bool local = true;
+      BOOST_FOREACH(const std::tr1::shared_ptr<Interaction>& ptr, interactions)
+	local = local && ptr->localOverlapChecks();
+
+      if (local)
+	nblist = getNeighbourList(getLongestInteraction());
+    }
+
+    size_t nThreads = 0;
+    if (Sim->ptrScheduler)
+      nThreads = Sim->ptrScheduler->getThreadPool().getThreadCount();
+
+    //Use several blocks per thread to even out the load
+    const size_t nBlocks = std::max(size_t(1), 8 * nThreads);
+    std::vector<OverlapBlock> blocks;
+    blocks.reserve(nBlocks);
+    for (size_t i(0); i < nBlocks; ++i)
+      blocks.push_back(OverlapBlock(Sim, nblist, (Sim->N * i) / nBlocks, 
+				    (Sim->N * (i + 1)) / nBlocks));
+    
+    if (nThreads)
+      {
+	std::vector<magnet::function::Task*> tasks;
+	for (size_t i(0); i < nBlocks; ++i)
+	  tasks.push_back(magnet::function::Task::makeTask(&OverlapBlock::run, &blocks[i]));
+
+	Sim->ptrScheduler->getThreadPool().queueTasks(tasks);
+	Sim->ptrScheduler->getThreadPool().wait();
+      }
+    else
+      for (size_t i(0); i < nBlocks; ++i)
+	blocks[i].run();
+
+    std::vector<IDPair> pairs;
+    BOOST_FOREACH(const OverlapBlock& block, blocks)
+      pairs.insert(pairs.end(), block.pairs.begin(), block.pairs.end());
+
+    //Captured pairs may have escaped the neighbour list
+    if (nblist)
+      {
+	std::vector<IDPair> captured;
+	BOOST_FOREACH(const std::tr1::shared_ptr<Interaction>& ptr, interactions)
+	  if (const ICapture* capture = dynamic_cast<const ICapture*>(ptr.get()))
+	    capture->getCapturedPairs(captured);
+
+	BOOST_FOREACH(const IDPair& IDs, captured)
+	  {
+	    const Particle& p1 = Sim->particleList[IDs.first];
+	    const Particle& p2 = Sim->particleList[IDs.second];
+	    if (getInteraction(p1, p2)->checkOverlaps(p1, p2, false))
+	      pairs.push_back(IDs);
+	  }
+      }
+
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    //Now describe the invalid pairs, in the order of a serial test of
+    //every pair
+    BOOST_FOREACH(const IDPair& IDs, pairs)
+      {
+	const Particle& p1 = Sim->particleList[IDs.first];
+	const Particle& p2 = Sim->particleList[IDs.second];
+	getInteraction(p1, p2)->checkOverlaps(p1, p2);
+      }
 
     BOOST_FOREACH(const Particle& part, Sim->particleList)
       BOOST_FOREACH(const std::tr1::shared_ptr<Local>& lcl, locals)
@@ -37,6 +37,7 @@ namespace dynamo {
   class Species;
   class GlobalEvent;
   class Global;
+  class GNeighbourList;
   class Local;
   class LocalEvent;
   class System;
@@ -84,17 +85,12 @@ namespace dynamo {
   
     inline IntEvent getEvent(const Particle& p1, const Particle& p2) const
     {
-      BOOST_FOREACH(const std::tr1::shared_ptr<Interaction>& ptr, interactions)
-	if (ptr->isInteraction(p1,p2))
-	  {
+      const std::tr1::shared_ptr<Interaction>& ptr = getInteraction(p1, p2);
 #ifdef dynamo_UpdateCollDebug
-	    std::cerr << "\nGOT INTERACTION P1 = " << p1.getID() << " P2 = " 
-		      << p2.getID() << " NAME = " << typeid(*(ptr.get())).name();
+      std::cerr << "\nGOT INTERACTION P1 = " << p1.getID() << " P2 = " 
+		<< p2.getID() << " NAME = " << typeid(*(ptr.get())).name();
 #endif
-	    return ptr->getEvent(p1,p2);
-	  }
-    
-      M_throw() << "Could not find the right interaction to test for";
+      return ptr->getEvent(p1,p2);
     }
 
     void operator<<(const magnet::xml::Node&);
@@ -102,6 +98,12 @@ namespace dynamo {
     void initialise();
   
     double getLongestInteraction() const;
+
+    /*! \brief Returns a neighbour list which holds every particle and
+     * supports interactions up to maxDist apart, or NULL if there is
+     * none.
+     */
+    const GNeighbourList* getNeighbourList(double maxDist) const;
   
     /*! \brief Sets the Centre of Mass (COM) velocity of the system 
      * 
@@ -126,6 +128,14 @@ namespace dynamo {
      */  
     void setCOMVelocity(const Vector COMVelocity = Vector(0,0,0));
 
+    /*! \brief Tests the system for invalid states (e.g., overlapping
+     * particles) and describes them on derr.
+     *
+     * The pairs are found through a neighbour list when possible (see
+     * Interaction::localOverlapChecks), and are shared between the
+     * threads of the Scheduler. Invalid pairs are described in
+     * ascending order of their particle IDs.
+     */
     void SystemOverlapTest();
   
     double calcInternalEnergy() const;
@@ -208,6 +218,35 @@ namespace dynamo {
   protected:
     void outputXML(magnet::xml::XmlStream &) const;
 
+    void buildInteractionLookup();
+
+    inline size_t getSpeciesIndex(const Particle& p) const
+    { return _particleSpecies.empty() ? 0 : _particleSpecies[p.getID()]; }
+
+    /*! \brief The interactions which may act between a pair of
+     * species.
+     *
+     * The candidates are the indices of the interactions which cover
+     * at least some of the pairs of the two species, in the order of
+     * precedence of the interactions. If certain is set, the last
+     * candidate covers all of the pairs remaining and does not need
+     * to be tested.
+     */
+    struct InteractionLookup
+    {
+      InteractionLookup(): certain(false) {}
+      std::vector<size_t> candidates;
+      bool certain;
+    };
+
+    //! The table of candidate interactions, indexed by the species
+    //! indices of the pair (s1 * species.size() + s2).
+    std::vector<InteractionLookup> _interactionLookup;
+
+    //! The index of the species of each particle, this is left empty
+    //! for single species systems.
+    std::vector<unsigned int> _particleSpecies;
+
     std::vector<std::tr1::shared_ptr<Interaction> > interactions;
     std::vector<std::tr1::shared_ptr<Global> > globals;
     std::vector<std::tr1::shared_ptr<Local> > locals;
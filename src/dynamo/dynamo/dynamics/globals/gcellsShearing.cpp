@@ -238,7 +238,7 @@ namespace dynamo {
 	      {
 		newNBCell[dim1] %= cellCount[dim1];
   
-		BOOST_FOREACH(const size_t& next, list[newNBCell.getMortonNum()])
+		BOOST_FOREACH(const size_t& next, cellContents(newNBCell.getMortonNum()))
 		  BOOST_FOREACH(const nbHoodSlot& nbs, sigNewNeighbourNotify)
 		    nbs.second(part, next);
 	  
@@ -318,7 +318,7 @@ namespace dynamo {
 	    for (size_t j(0); j < cellCount[0]; ++j)
 	      {
 		
-		BOOST_FOREACH(const size_t& next, list[cellCoords.getMortonNum()])
+		BOOST_FOREACH(const size_t& next, cellContents(cellCoords.getMortonNum()))
 		  func(next);
 		
 		++cellCoords[0];
@@ -355,7 +355,7 @@ namespace dynamo {
 
 	for (size_t j(0); j < cellCount[0]; ++j)
 	  {
-	    BOOST_FOREACH(const size_t& next, list[cellCoords.getMortonNum()])
+	    BOOST_FOREACH(const size_t& next, cellContents(cellCoords.getMortonNum()))
 	      func(part, next);
 
 	    ++cellCoords[0];
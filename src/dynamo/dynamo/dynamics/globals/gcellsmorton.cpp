@@ -30,12 +30,15 @@
 #include <cstdio>
 
 namespace dynamo {
+  const uint32_t GCells::_noCell;
+
   GCells::GCells(dynamo::SimData* nSim, const std::string& name, size_t overlink):
     GNeighbourList(nSim, "MortonCellNeighbourList"),
     cellDimension(1,1,1),
     _oversizeCells(1.0),
     NCells(0),
-    overlink(overlink)
+    overlink(overlink),
+    _cellStride(8)
   {
     globName = name;
     dout << "Cells Loaded" << std::endl;
@@ -46,7 +49,8 @@ namespace dynamo {
     cellDimension(1,1,1),
     _oversizeCells(1.0),
     NCells(0),
-    overlink(1)
+    overlink(1),
+    _cellStride(8)
   {
     operator<<(XML);
 
@@ -113,9 +117,7 @@ namespace dynamo {
     //expect the particle to be up to date.
     Sim->dynamics.getLiouvillean().updateParticle(part);
 
-    boost::unordered_map<size_t, size_t>::iterator it = partCellData.find(part.getID());
-
-    const size_t oldCell(it->second);
+    const size_t oldCell(partCellData[part.getID()]);
 
     size_t endCell;
 
@@ -152,7 +154,7 @@ namespace dynamo {
       endCell = dendCell.getMortonNum();
     }
     
-    removeFromCellwIt(part.getID(), it);
+    removeFromCell(part.getID());
     addToCell(part.getID(), endCell);
 
     //Get rid of the virtual event we're running, an updated event is
@@ -184,7 +186,7 @@ namespace dynamo {
 	  {
 	    newNBCell[dim1] %= cellCount[dim1];
   
-	    BOOST_FOREACH(const size_t& next, list[newNBCell.getMortonNum()])
+	    BOOST_FOREACH(const size_t& next, cellContents(newNBCell.getMortonNum()))
 	      BOOST_FOREACH(const nbHoodSlot& nbs, sigNewNeighbourNotify)
 	        nbs.second(part, next);
 	  
@@ -241,7 +243,7 @@ namespace dynamo {
 
     reinitialise();
 
-    dout << "Neighbourlist contains " << partCellData.size() 
+    dout << "Neighbourlist contains " << range->size() 
 	 << " particle entries";
   }
 
@@ -333,8 +335,15 @@ namespace dynamo {
     magnet::math::MortonNumber<3> coords(cellCount[0], cellCount[1], cellCount[2]);
     size_t sizeReq = coords.getMortonNum();
 
+    if (sizeReq >= _noCell)
+      M_throw() << "Too many cells for the neighbour list, try larger cells";
+
     cells.resize(sizeReq); //Empty Cells created!
-    list.resize(sizeReq); //Empty Cells created!
+    _cellStride = 8;
+    list.clear();
+    list.resize(sizeReq * _cellStride, 0); //Empty Cells created!
+    partCellData.clear();
+    partCellData.resize(Sim->N, _noCell);
 
     dout << "Vector Size <N>  " << sizeReq << std::endl;
   
@@ -350,10 +359,41 @@ namespace dynamo {
 	addToCell(id);
       }
 
-    dout << "\nCell loading " << float(partCellData.size()) / NCells 
+    dout << "\nCell loading " << float(range->size()) / NCells 
 	 << std::endl;
   }
 
+  void
+  GCells::getMortonOrder(std::vector<size_t>& order) const
+  {
+    order.clear();
+    order.reserve(Sim->N);
+
+    const size_t nCells = list.size() / _cellStride;
+    for (size_t cellID(0); cellID < nCells; ++cellID)
+      BOOST_FOREACH(const uint32_t& ID, cellContents(cellID))
+	order.push_back(ID);
+
+    for (size_t ID(0); ID < Sim->N; ++ID)
+      if ((ID >= partCellData.size()) || (partCellData[ID] == _noCell))
+	order.push_back(ID);
+  }
+
+  void
+  GCells::growCells() const
+  {
+    const size_t nCells = list.size() / _cellStride;
+    std::vector<uint32_t> newList(nCells * 2 * _cellStride, 0);
+
+    for (size_t i(0); i < nCells; ++i)
+      std::copy(list.begin() + i * _cellStride, 
+		list.begin() + i * _cellStride + 1 + list[i * _cellStride],
+		newList.begin() + i * 2 * _cellStride);
+
+    list.swap(newList);
+    _cellStride *= 2;
+  }
+
   void 
   GCells::addLocalEvents()
   {
@@ -413,7 +453,7 @@ namespace dynamo {
     magnet::math::MortonNumber<3> coords(zero_coords);
     while (coords[2] != max_coords[2])
       {
-	BOOST_FOREACH(const size_t& next, list[coords.getMortonNum()])
+	BOOST_FOREACH(const size_t& next, cellContents(coords.getMortonNum()))
 	  func(part, next);
       
 	++coords[0];
@@ -451,7 +491,7 @@ namespace dynamo {
     magnet::math::MortonNumber<3> coords(zero_coords);
     while (coords[2] != max_coords[2])
       {
-	BOOST_FOREACH(const size_t& next, list[coords.getMortonNum()])
+	BOOST_FOREACH(const size_t& next, cellContents(coords.getMortonNum()))
 	  func(next);
       
 	++coords[0];
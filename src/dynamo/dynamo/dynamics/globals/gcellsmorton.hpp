@@ -19,7 +19,7 @@
 #include <dynamo/dynamics/globals/neighbourList.hpp>
 #include <dynamo/simulation/particle.hpp>
 #include <magnet/math/morton_number.hpp>
-#include <boost/unordered_map.hpp>
+#include <stdint.h>
 #include <vector>
 
 namespace dynamo {
@@ -41,11 +41,14 @@ namespace dynamo {
     helps prevent local event objects (like walls) falling numerically
     outside all cells when the wall lies on the cell border.
 
-    The second property is that the contents of each cell is stored as
-    a std::vector. In theory, a linked list is far more memory
-    efficient however, the vector is much more cache friendly and can
-    boost performance by 50% in cases where the cell has multiple
-    particles inside of it.
+    The second property is that the contents of all cells are stored
+    in a single flat array, where each cell has a fixed size block of
+    entries. The first entry of a block is the number of particles in
+    the cell, followed by the particle IDs. In theory, a linked list is
+    far more memory efficient however, the contiguous storage is much
+    more cache friendly as a cell and its count usually sit on a single
+    cache line. If a cell overflows its block, the blocks of all cells
+    are doubled in size.
    */
   class GCells: public GNeighbourList
   {
@@ -77,8 +80,35 @@ namespace dynamo {
     Vector getCellDimensions() const 
     { return cellDimension; }
 
+    //! \brief The number of cells along a dimension.
+    size_t getCellCount(size_t dim) const
+    { return cellCount[dim]; }
+
+    //! \brief The position of the lower corner of a cell.
+    Vector getCellOrigin(const magnet::math::MortonNumber<3>& coords) const
+    { return calcPosition(coords); }
+
+    /*! \brief Looks up the cell a particle is sorted into.
+
+      \returns false if the particle is not in this neighbour list.
+     */
+    bool getParticleCell(size_t ID, size_t& cellID) const
+    {
+      if ((ID >= partCellData.size()) || (partCellData[ID] == _noCell))
+	return false;
+
+      cellID = partCellData[ID];
+      return true;
+    }
+
     virtual double getMaxSupportedInteractionLength() const;
 
+    /*! \brief Fills order with the IDs of all the particles, with
+      the particles of this neighbour list in the Morton order of
+      their cells, followed by the remaining particles in ID order.
+     */
+    void getMortonOrder(std::vector<size_t>& order) const;
+
   protected:
     size_t cellCount[3];
     magnet::math::DilatedInteger<3> dilatedCellMax[3];
@@ -93,18 +123,36 @@ namespace dynamo {
     boost::signals2::scoped_connection _particleAdded;
     boost::signals2::scoped_connection _particleRemoved;
 
-    //! \brief The start of the list of particles in each cell.
-    mutable std::vector<std::vector<size_t> > list;
+    //! \brief The value of partCellData for particles not in a cell.
+    static const uint32_t _noCell = 0xFFFFFFFF;
+
+    //! \brief The number of entries in the block of each cell in list.
+    mutable size_t _cellStride;
+
+    //! \brief The count and particle IDs of each cell, in blocks
+    //! of _cellStride entries.
+    mutable std::vector<uint32_t> list;
 
     //! \brief The local events in each cell.
     mutable std::vector<std::vector<size_t> > cells;
 
     /*! \brief The cell for a given particle.
       
-      This container is an unordered map, so we only store the linked
-      list for the particles actually inserted into this neighborlist.
+      This is indexed by the particle ID, particles which are not in
+      this neighbour list are marked with _noCell.
      */
-    mutable boost::unordered_map<size_t, size_t> partCellData;
+    mutable std::vector<uint32_t> partCellData;
+
+    //! \brief The particle IDs in a cell, as a range for BOOST_FOREACH.
+    inline std::pair<const uint32_t*, const uint32_t*> 
+    cellContents(size_t cellID) const
+    {
+      const uint32_t* start = &list[cellID * _cellStride] + 1;
+      return std::make_pair(start, start + start[-1]);
+    }
+
+    //! \brief Doubles the size of the block of every cell.
+    void growCells() const;
 
     GCells(const GCells&);
 
@@ -127,38 +175,36 @@ namespace dynamo {
 
     inline void addToCell(size_t ID, size_t cellID) const
     {
-      list[cellID].push_back(ID);
+      if (list[cellID * _cellStride] + 1 == _cellStride) growCells();
+
+      uint32_t* cell = &list[cellID * _cellStride];
+      cell[++cell[0]] = ID;
+
+      if (ID >= partCellData.size())
+	partCellData.resize(ID + 1, _noCell);
+
       partCellData[ID] = cellID;
     }
   
     inline void removeFromCell(size_t ID) const
-    { removeFromCellwIt(ID, partCellData.find(ID)); }
-
-    inline void removeFromCellwIt(size_t ID, boost::unordered_map<size_t, size_t>::iterator it) const
     {
 #ifdef DYNAMO_DEBUG
-    if (it == partCellData.end())
-      M_throw() << "Could not find the particle's cell data";
+      if ((ID >= partCellData.size()) || (partCellData[ID] == _noCell))
+	M_throw() << "Could not find the particle's cell data";
 #endif
-      const size_t cellID = it->second;
+      uint32_t* cell = &list[partCellData[ID] * _cellStride];
       //Erase the cell data
-      partCellData.quick_erase(it);
-
-      std::vector<std::vector<size_t> >::iterator listIt = list.begin() + cellID;
-#ifdef DYNAMO_DEBUG
-    if (listIt == list.end())
-      M_throw() << "Could not find the particle's cell data";
-#endif
+      partCellData[ID] = _noCell;
 
-      std::vector<size_t>::iterator pit = std::find(listIt->begin(), listIt->end(), ID);      
+      uint32_t* pit = std::find(cell + 1, cell + 1 + cell[0], ID);
 
 #ifdef DYNAMO_DEBUG
-      if (pit == listIt->end())
+      if (pit == cell + 1 + cell[0])
 	M_throw() << "Removing a particle (ID=" << ID << ") which is not in a cell";
 #endif
 
-      *pit = listIt->back();
-      listIt->pop_back();
+      *pit = cell[cell[0]];
+      --cell[0];
     }
   };
 }
@@ -170,7 +170,7 @@ namespace dynamo {
     {    
       sigReInitNotify.push_back
 	(initSlot(++sigReInitNotifyCount, 
-		  getInitDelegate(func,tp)));
+		  initFunc(tp, func)));
     
       return sigReInitNotifyCount; 
     }
@@ -20,24 +20,120 @@
 #include <dynamo/base/is_simdata.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <dynamo/dynamics/globals/neighbourList.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <magnet/thread/threadpool.hpp>
 #include <boost/foreach.hpp>
+#include <algorithm>
 
 namespace dynamo {
+  namespace detail {
+    /*! \brief A block of particles to be tested while rebuilding a
+     * capture map.
+     *
+     * The block tests the pairs (i, j) with i in [start, end) and j >
+     * i, using the neighbour list if one is given. The captured pairs
+     * are then sorted into the order a serial test of every pair
+     * would find them.
+     */
+    template<class Capture, class Value>
+    struct CaptureBlock
+    {
+      typedef std::pair<std::pair<size_t, size_t>, Value> Pair;
+
+      CaptureBlock(const Capture* capture_in, const SimData* Sim_in, 
+		   const GNeighbourList* nblist_in, size_t start_in, size_t end_in):
+	capture(capture_in), Sim(Sim_in), nblist(nblist_in), 
+	start(start_in), end(end_in)
+      {}
+
+      void run()
+      {
+	for (size_t ID(start); ID < end; ++ID)
+	  if (nblist)
+	    nblist->getParticleNeighbourhood
+	      (Sim->particleList[ID], magnet::function::MakeDelegate(this, &CaptureBlock::test));
+	  else
+	    for (size_t ID2(ID + 1); ID2 < Sim->N; ++ID2)
+	      test(Sim->particleList[ID], ID2);
+
+	std::sort(pairs.begin(), pairs.end());
+	pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+      }
+
+      void test(const Particle& p1, const size_t& ID2)
+      {
+	if (ID2 <= p1.getID()) return;
+
+	Value val = capture->captureTest(p1, Sim->particleList[ID2]);
+	if (val)
+	  pairs.push_back(Pair(std::make_pair(p1.getID(), ID2), val));
+      }
+
+      const Capture* capture;
+      const SimData* Sim;
+      const GNeighbourList* nblist;
+      size_t start;
+      size_t end;
+      std::vector<Pair> pairs;
+    };
+  }
+
+  namespace {
+    /*! \brief Splits the particles into blocks and finds the
+     * captured pairs of each block, using the threads of the
+     * Scheduler.
+     */
+    template<class Capture, class Value>
+    void runCaptureBlocks(const Capture* capture, SimData* Sim, double maxDist,
+			  std::vector<detail::CaptureBlock<Capture, Value> >& blocks)
+    {
+      const GNeighbourList* nblist = Sim->dynamics.getNeighbourList(maxDist);
+      
+      size_t nThreads = 0;
+      if (Sim->ptrScheduler)
+	nThreads = Sim->ptrScheduler->getThreadPool().getThreadCount();
+
+      //Use several blocks per thread to even out the load
+      const size_t nBlocks = std::max(size_t(1), 8 * nThreads);
+      blocks.clear();
+      blocks.reserve(nBlocks);
+      for (size_t i(0); i < nBlocks; ++i)
+	blocks.push_back(detail::CaptureBlock<Capture, Value>
+			 (capture, Sim, nblist, (Sim->N * i) / nBlocks, 
+			  (Sim->N * (i + 1)) / nBlocks));
+
+      if (nThreads)
+	{
+	  std::vector<magnet::function::Task*> tasks;
+	  for (size_t i(0); i < nBlocks; ++i)
+	    tasks.push_back(magnet::function::Task::makeTask
+			    (&detail::CaptureBlock<Capture, Value>::run, &blocks[i]));
+
+	  Sim->ptrScheduler->getThreadPool().queueTasks(tasks);
+	  Sim->ptrScheduler->getThreadPool().wait();
+	}
+      else
+	for (size_t i(0); i < nBlocks; ++i)
+	  blocks[i].run();
+    }
+  }
+
   void 
-  ISingleCapture::initCaptureMap(const std::vector<Particle>& particleList)
+  ISingleCapture::initCaptureMap(dynamo::SimData* Sim, double maxDist)
   {
     //If not loaded or invalidated
     if (noXmlLoad)
       {
 	captureMap.clear();
-      
-	for (std::vector<Particle>::const_iterator iPtr
-	       = particleList.begin();
-	     iPtr != particleList.end(); iPtr++)
-	  for (std::vector<Particle>::const_iterator iPtr2 = iPtr + 1;
-	       iPtr2 != particleList.end(); iPtr2++)
-	    if (captureTest(*iPtr,*iPtr2))
-	      addToCaptureMap(*iPtr, *iPtr2);
+
+	typedef detail::CaptureBlock<ISingleCapture, bool> Block;
+	std::vector<Block> blocks;
+	runCaptureBlocks(this, Sim, maxDist, blocks);
+
+	BOOST_FOREACH(const Block& block, blocks)
+	  BOOST_FOREACH(const Block::Pair& IDs, block.pairs)
+	    captureMap.insert(cMapKey(IDs.first.first, IDs.first.second));
       }
   }
 
@@ -74,24 +170,20 @@ namespace dynamo {
   //////////////////////////////////////////////////////
 
   void 
-  IMultiCapture::initCaptureMap(const std::vector<Particle>& particleList)
+  IMultiCapture::initCaptureMap(dynamo::SimData* Sim, double maxDist)
   {
     //If not loaded or invalidated
     if (noXmlLoad)
       {      
 	captureMap.clear();
-      
-	for (std::vector<Particle>::const_iterator iPtr 
-	       = particleList.begin();
-	     iPtr != particleList.end(); iPtr++) 
-	  for (std::vector<Particle>::const_iterator iPtr2 = iPtr + 1;
-	       iPtr2 != particleList.end(); iPtr2++)
-	    {
-	      int capval = captureTest(*iPtr,*iPtr2);
-	      if (captureTest(*iPtr,*iPtr2))
-		captureMap[cMapKey(iPtr->getID(), iPtr2->getID())] 
-		  = capval; 
-	    }
+
+	typedef detail::CaptureBlock<IMultiCapture, int> Block;
+	std::vector<Block> blocks;
+	runCaptureBlocks(this, Sim, maxDist, blocks);
+
+	BOOST_FOREACH(const Block& block, blocks)
+	  BOOST_FOREACH(const Block::Pair& IDs, block.pairs)
+	    captureMap[cMapKey(IDs.first.first, IDs.first.second)] = IDs.second;
       }
   }
 
@@ -24,6 +24,10 @@
 #include <vector>
 
 namespace dynamo {
+  class SimData;
+
+  namespace detail { template<class, class> struct CaptureBlock; }
+
   /*! \brief A general interface for \ref Interaction classes with
    *  states for the particle pairs.
    *
@@ -44,6 +48,25 @@ namespace dynamo {
     //! \brief Returns the total internal energy stored in this Interaction.
     virtual double getInternalEnergy() const = 0;
 
+    /*! \brief Rebuilds the map of captured pairs, unless it was
+     * loaded from the configuration file.
+     *
+     * This is called by Dynamics::initialise once the neighbour lists
+     * are initialised. If a neighbour list holds every particle and
+     * supports the interaction distance, only the neighbouring pairs
+     * are tested. Otherwise every pair is tested. The tests are shared
+     * between the threads of the Scheduler, and the result is
+     * identical to a serial test of every pair.
+     *
+     * \param Sim The simulation holding the particles.
+     * \param maxDist The maximum distance a captured pair may be
+     * apart.
+     */
+    virtual void initCaptureMap(dynamo::SimData* Sim, double maxDist) = 0;
+
+    //! \brief Appends the IDs of every captured pair, the lower ID first.
+    virtual void getCapturedPairs(std::vector<std::pair<size_t, size_t> >& pairs) const = 0;
+
   protected:
     /*! \brief A key used to represent two particles.
      *
@@ -78,6 +101,11 @@ namespace dynamo {
     ISingleCapture():noXmlLoad(true) {}
 
     size_t getTotalCaptureCount() const { return captureMap.size(); }
+
+    virtual void initCaptureMap(dynamo::SimData* Sim, double maxDist);
+
+    virtual void getCapturedPairs(std::vector<std::pair<size_t, size_t> >& pairs) const
+    { pairs.insert(pairs.end(), captureMap.begin(), captureMap.end()); }
   
     virtual bool isCaptured(const Particle& p1, const Particle& p2) const
     { return captureMap.count(cMapKey(p1.getID(), p2.getID())); }
@@ -96,7 +124,7 @@ namespace dynamo {
 
     bool noXmlLoad;
 
-    void initCaptureMap(const std::vector<Particle>& particleList);
+    friend struct detail::CaptureBlock<ISingleCapture, bool>;
 
     /*! \brief Function to load the capture map. 
      *
@@ -146,6 +174,14 @@ namespace dynamo {
     IMultiCapture(): noXmlLoad(true) {}
 
     size_t getTotalCaptureCount() const { return captureMap.size(); }
+
+    virtual void initCaptureMap(dynamo::SimData* Sim, double maxDist);
+
+    virtual void getCapturedPairs(std::vector<std::pair<size_t, size_t> >& pairs) const
+    {
+      for (const_cmap_it it = captureMap.begin(); it != captureMap.end(); ++it)
+	pairs.push_back(it->first);
+    }
   
     virtual bool isCaptured(const Particle& p1, const Particle& p2) const
     { return captureMap.count(cMapKey(p1.getID(), p2.getID())); }
@@ -162,7 +198,7 @@ namespace dynamo {
 
     bool noXmlLoad;
 
-    void initCaptureMap(const std::vector<Particle>& particleList);
+    friend struct detail::CaptureBlock<IMultiCapture, int>;
 
     void loadCaptureMap(const magnet::xml::Node&);
 
@@ -42,8 +42,6 @@ namespace dynamo  {
   IDumbbells::initialise(size_t nID)
   {
     ID = nID; 
-  
-    ISingleCapture::initCaptureMap(Sim->particleList);
   }
 
   void 
@@ -257,7 +255,8 @@ namespace dynamo  {
 
   }
 
-  void
-  IDumbbells::checkOverlaps(const Particle& part1, const Particle& part2) const
-  {}
+  bool
+  IDumbbells::checkOverlaps(const Particle& part1, const Particle& part2, 
+			    bool textoutput) const
+  { return false; }
 }
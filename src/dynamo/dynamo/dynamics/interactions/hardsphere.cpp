@@ -38,7 +38,11 @@ namespace dynamo {
 
   void 
   IHardSphere::initialise(size_t nID)
-  { ID=nID; }
+  { 
+    ID=nID; 
+    _diameterValues = _diameter->getHandle();
+    _eValues = _e->getHandle();
+  }
 
   void 
   IHardSphere::operator<<(const magnet::xml::Node& XML)
@@ -101,8 +105,8 @@ namespace dynamo {
 
     CPDData colldat(*Sim, p1, p2);
 
-    double d2 = (_diameter->getProperty(p1.getID())
-		 + _diameter->getProperty(p2.getID())) * 0.5;
+    double d2 = (_diameterValues[p1.getID()]
+		 + _diameterValues[p2.getID()]) * 0.5;
     d2 *= d2;
 
     if (Sim->dynamics.getLiouvillean()
@@ -121,6 +125,60 @@ namespace dynamo {
     return IntEvent(p1,p2,HUGE_VAL, NONE, *this);  
   }
 
+  template<class DiameterHandle>
+  void
+  IHardSphere::batchedEvents(const Particle& p1, const size_t* IDs, size_t N, 
+			     IntEvent* events, const DiameterHandle& diameter) const
+  {
+    const Liouvillean& liouvillean = Sim->dynamics.getLiouvillean();
+    const double diameter1 = diameter[p1.getID()];
+    double d2[CPDBatch::maxSize], dt[CPDBatch::maxSize];
+
+    for (size_t start(0); start < N; start += CPDBatch::maxSize)
+      {
+	const CPDBatch colldat(*Sim, p1, IDs + start, 
+			       std::min(N - start, CPDBatch::maxSize));
+
+	for (size_t i(0); i < colldat.size; ++i)
+	  {
+	    d2[i] = (diameter1 + diameter[IDs[start + i]]) * 0.5;
+	    d2[i] *= d2[i];
+	  }
+
+	liouvillean.SphereSphereInRoots(colldat, d2, dt);
+
+	for (size_t i(0); i < colldat.size; ++i)
+	  {
+	    const Particle& p2 = Sim->particleList[IDs[start + i]];
+	    if (dt[i] != HUGE_VAL)
+	      events[start + i] = IntEvent(p1, p2, dt[i], CORE, *this);
+	    else
+	      events[start + i] = IntEvent(p1, p2, HUGE_VAL, NONE, *this);
+	  }
+      }
+  }
+
+  void
+  IHardSphere::getEvents(const Particle& p1, const size_t* IDs, size_t N, 
+			 IntEvent* events) const
+  {
+#if !defined(DYNAMO_DEBUG) && !defined(DYNAMO_OverlapTesting)
+    if (Sim->dynamics.getLiouvillean().hasBatchedSphereRoots())
+      {
+	//Monodisperse systems have their own kernel, with a constant
+	//interaction distance
+	if (_diameterValues.isConstant())
+	  batchedEvents(p1, IDs, N, events, ConstantPropertyHandle(_diameterValues[0]));
+	else
+	  batchedEvents(p1, IDs, N, events, _diameterValues);
+	return;
+      }
+#endif
+
+    //The per pair tests also check for overlaps in debug builds
+    Interaction::getEvents(p1, IDs, N, events);
+  }
+
   void
   IHardSphere::runEvent(const Particle& p1,
 			const Particle& p2,
@@ -128,12 +186,12 @@ namespace dynamo {
   {
     ++Sim->eventCount;
 
-    double d2 = (_diameter->getProperty(p1.getID())
-		 + _diameter->getProperty(p2.getID())) * 0.5;
+    double d2 = (_diameterValues[p1.getID()]
+		 + _diameterValues[p2.getID()]) * 0.5;
     d2 *= d2;
 
-    double e = (_e->getProperty(p1.getID())
-		+ _e->getProperty(p2.getID())) * 0.5;
+    double e = (_eValues[p1.getID()]
+		+ _eValues[p2.getID()]) * 0.5;
 
     PairEventData EDat
       (Sim->dynamics.getLiouvillean().SmoothSpheresColl(iEvent, e, d2)); 
@@ -157,9 +215,12 @@ namespace dynamo {
 	<< *range;
   }
 
-  void
-  IHardSphere::checkOverlaps(const Particle& part1, const Particle& part2) const
+  bool
+  IHardSphere::checkOverlaps(const Particle& part1, const Particle& part2, 
+			     bool textoutput) const
   {
+    bool retval = false;
+
     Vector  rij = part1.getPosition() - part2.getPosition();  
     Sim->dynamics.BCs().applyBC(rij); 
 
@@ -168,11 +229,17 @@ namespace dynamo {
     d2 *= d2;
   
     if ((rij | rij) < d2)
-      derr << std::setprecision(std::numeric_limits<float>::digits10)
-	   << "Possible overlap occured in diagnostics\n ID1=" << part1.getID() 
-	   << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-	   << (rij | rij) / pow(Sim->dynamics.units().unitLength(),2)
-	   << "\nd^2=" 
-	   << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+      {
+	if (textoutput)
+	  derr << std::setprecision(std::numeric_limits<float>::digits10)
+	       << "Possible overlap occured in diagnostics\n ID1=" << part1.getID() 
+	       << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+	       << (rij | rij) / pow(Sim->dynamics.units().unitLength(),2)
+	       << "\nd^2=" 
+	       << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	retval = true;
+      }
+
+    return retval;
   }
 }
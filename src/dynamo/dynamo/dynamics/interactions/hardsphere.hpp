@@ -53,15 +53,27 @@ namespace dynamo {
     virtual void rescaleLengths(double) {}
 
     virtual IntEvent getEvent(const Particle&, const Particle&) const;
+
+    virtual void getEvents(const Particle&, const size_t*, size_t, IntEvent*) const;
  
     virtual void runEvent(const Particle&, const Particle&, const IntEvent&) const;
    
     virtual void outputXML(magnet::xml::XmlStream&) const;
 
-    virtual void checkOverlaps(const Particle&, const Particle&) const;
+    virtual bool checkOverlaps(const Particle&, const Particle&, bool textoutput = true) const;
 
   protected:
+    //! The batched form of getEvents, instantiated for constant and
+    //! per-particle diameters.
+    template<class DiameterHandle>
+    void batchedEvents(const Particle&, const size_t*, size_t, IntEvent*, 
+		       const DiameterHandle&) const;
+
     std::tr1::shared_ptr<Property> _diameter;
     std::tr1::shared_ptr<Property> _e;
+
+    //! Handles to the values of the properties, set in initialise.
+    PropertyHandle _diameterValues;
+    PropertyHandle _eValues;
   };
 }
@@ -33,6 +33,14 @@ namespace dynamo {
   Interaction::operator<<(const magnet::xml::Node& XML)
   { range = std::tr1::shared_ptr<C2Range>(C2Range::getClass(XML,Sim)); }
 
+  void 
+  Interaction::getEvents(const Particle& p1, const size_t* IDs, size_t N, 
+			 IntEvent* events) const
+  {
+    for (size_t i(0); i < N; ++i)
+      events[i] = getEvent(p1, Sim->particleList[IDs[i]]);
+  }
+
   bool 
   Interaction::isInteraction(const IntEvent &coll) const
   { 
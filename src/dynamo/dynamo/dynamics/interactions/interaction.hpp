@@ -68,6 +68,21 @@ namespace dynamo {
     virtual IntEvent getEvent(const Particle &, 
 			      const Particle &) const = 0;
 
+    /*! \brief Calculate the events between a particle and several
+     * others.
+     *
+     * This is equivalent to calling getEvent for each pair, but
+     * allows an Interaction to test the pairs together. The
+     * particles must all be up to date.
+     *
+     * \param p1 The first particle of every pair.
+     * \param IDs The IDs of the second particles of the pairs.
+     * \param N The number of pairs.
+     * \param events The event of each pair is written here.
+     */
+    virtual void getEvents(const Particle& p1, const size_t* IDs, size_t N, 
+			   IntEvent* events) const;
+
     //! Run the dynamics of an event that is occuring now.
     virtual void runEvent(const Particle&, const Particle&, const IntEvent&) const = 0;
 
@@ -121,8 +136,24 @@ namespace dynamo {
     //! Interaction can generate events for.
     const std::tr1::shared_ptr<C2Range>& getRange() const;
 
-    //! Test if an invalid state has occurred between the two passed particles
-    virtual void checkOverlaps(const Particle&, const Particle&) const = 0;
+    /*! \brief Test if an invalid state has occurred between the two
+     * passed particles.
+     *
+     * \param textoutput If true, any invalid state found is described
+     * on derr.
+     * \return True if an invalid state was found.
+     */
+    virtual bool checkOverlaps(const Particle&, const Particle&, bool textoutput = true) const = 0;
+
+    /*! \brief Returns true if checkOverlaps can only find an invalid
+     * state for captured pairs (see ICapture) or pairs closer than
+     * maxIntDist().
+     *
+     * When this holds for every Interaction,
+     * Dynamics::SystemOverlapTest only tests the pairs found through
+     * a neighbour list, and the captured pairs.
+     */
+    virtual bool localOverlapChecks() const { return true; }
 
     //! Return the ID number of the Interaction. Used for fast look-ups,
     //! once a name-based look up has been completed.
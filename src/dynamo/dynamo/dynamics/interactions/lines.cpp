@@ -41,8 +41,6 @@ namespace dynamo {
   ILines::initialise(size_t nID)
   {
     ID = nID; 
-  
-    ISingleCapture::initCaptureMap(Sim->particleList);
   }
 
   void 
@@ -51,7 +51,8 @@ namespace dynamo {
    
     virtual void outputXML(magnet::xml::XmlStream&) const;
 
-    virtual void checkOverlaps(const Particle&, const Particle&) const {}
+    virtual bool checkOverlaps(const Particle&, const Particle&, bool textoutput = true) const
+    { return false; }
  
     virtual bool captureTest(const Particle&, const Particle&) const;
 
@@ -44,7 +44,8 @@ namespace dynamo {
    
     virtual void outputXML(magnet::xml::XmlStream&) const;
 
-    virtual void checkOverlaps(const Particle&, const Particle&) const {}
+    virtual bool checkOverlaps(const Particle&, const Particle&, bool textoutput = true) const
+    { return false; }
  
   protected:
   };
@@ -157,9 +157,12 @@ namespace dynamo {
 	<< magnet::xml::endtag("Rotation");
   }
 
-  void
-  IRotatedParallelCubes::checkOverlaps(const Particle& part1, const Particle& part2) const
+  bool
+  IRotatedParallelCubes::checkOverlaps(const Particle& part1, const Particle& part2, 
+				       bool textoutput) const
   {
+    bool retval = false;
+
     Vector  rij = part1.getPosition() - part2.getPosition();  
     Sim->dynamics.BCs().applyBC(rij); 
 
@@ -167,11 +170,17 @@ namespace dynamo {
 		+ _diameter->getProperty(part2.getID())) * 0.5;
   
     if ((rij | rij) < d * d)
-      derr << "Possible overlap occured in diagnostics\n ID1=" << part1.getID() 
-	   << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-	   << (rij | rij) / pow(Sim->dynamics.units().unitLength(), 2)
-	   << "\nd^2=" 
-	   << d * d / pow(Sim->dynamics.units().unitLength(), 2) << std::endl;
+      {
+	if (textoutput)
+	  derr << "Possible overlap occured in diagnostics\n ID1=" << part1.getID() 
+	       << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+	       << (rij | rij) / pow(Sim->dynamics.units().unitLength(), 2)
+	       << "\nd^2=" 
+	       << d * d / pow(Sim->dynamics.units().unitLength(), 2) << std::endl;
+	retval = true;
+      }
+
+    return retval;
   }
 }
 
@@ -169,9 +169,12 @@ namespace dynamo {
 	<< *range;
   }
 
-  void
-  IRoughHardSphere::checkOverlaps(const Particle& part1, const Particle& part2) const
+  bool
+  IRoughHardSphere::checkOverlaps(const Particle& part1, const Particle& part2, 
+				  bool textoutput) const
   {
+    bool retval = false;
+
     Vector  rij = part1.getPosition() - part2.getPosition();  
     Sim->dynamics.BCs().applyBC(rij); 
 
@@ -180,11 +183,17 @@ namespace dynamo {
     d2 *= d2;
   
     if ((rij | rij) < d2)
-      derr << "Possible overlap occured in diagnostics\n ID1=" << part1.getID() 
-	   << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-	   << (rij | rij) / pow(Sim->dynamics.units().unitLength(),2)
-	   << "\nd^2=" 
-	   << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+      {
+	if (textoutput)
+	  derr << "Possible overlap occured in diagnostics\n ID1=" << part1.getID() 
+	       << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+	       << (rij | rij) / pow(Sim->dynamics.units().unitLength(),2)
+	       << "\nd^2=" 
+	       << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	retval = true;
+      }
+
+    return retval;
   }
 }
 
@@ -58,7 +58,7 @@ namespace dynamo {
    
     virtual void outputXML(magnet::xml::XmlStream&) const;
 
-    virtual void checkOverlaps(const Particle&, const Particle&) const;
+    virtual bool checkOverlaps(const Particle&, const Particle&, bool textoutput = true) const;
 
   protected:
     std::tr1::shared_ptr<Property> _diameter;
@@ -68,7 +68,6 @@ namespace dynamo {
   ISoftCore::initialise(size_t nID)
   {
     ID = nID;
-    ISingleCapture::initCaptureMap(Sim->particleList);
   }
 
   double 
@@ -201,9 +200,12 @@ namespace dynamo {
       }
   }
 
-  void
-  ISoftCore::checkOverlaps(const Particle& part1, const Particle& part2) const
+  bool
+  ISoftCore::checkOverlaps(const Particle& part1, const Particle& part2, 
+			   bool textoutput) const
   {
+    bool retval = false;
+
     Vector  rij = part1.getPosition() - part2.getPosition();
     Sim->dynamics.BCs().applyBC(rij);
     double r2 = rij.nrm2();
@@ -215,19 +217,29 @@ namespace dynamo {
     if (isCaptured(part1, part2))
       {
 	if (r2 > d2)
-	  derr << "Possible escaped captured pair in diagnostics\n ID1=" << part1.getID() 
-	       << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-	       << r2 / pow(Sim->dynamics.units().unitLength(),2)
-	       << "\nd^2=" 
-	       << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	  {
+	    if (textoutput)
+	      derr << "Possible escaped captured pair in diagnostics\n ID1=" << part1.getID() 
+		   << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+		   << r2 / pow(Sim->dynamics.units().unitLength(),2)
+		   << "\nd^2=" 
+		   << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	    retval = true;
+	  }
       }
     else 
       if (r2 < d2)
-	derr << "Possible missed captured pair in diagnostics\n ID1=" << part1.getID() 
-	     << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-	     << r2 / pow(Sim->dynamics.units().unitLength(),2)
-	     << "\nd^2=" 
-	     << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	{
+	  if (textoutput)
+	    derr << "Possible missed captured pair in diagnostics\n ID1=" << part1.getID() 
+		 << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+		 << r2 / pow(Sim->dynamics.units().unitLength(),2)
+		 << "\nd^2=" 
+		 << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	  retval = true;
+	}
+
+    return retval;
   }
   
   void 
@@ -46,7 +46,7 @@ namespace dynamo {
 
     virtual double maxIntDist() const;
 
-    virtual void checkOverlaps(const Particle&, const Particle&) const;
+    virtual bool checkOverlaps(const Particle&, const Particle&, bool textoutput = true) const;
 
     virtual bool captureTest(const Particle&, const Particle&) const;
 
@@ -104,9 +104,12 @@ namespace dynamo {
     return (rij | rij) <= ld2;
   }
 
-  void
-  ISquareBond::checkOverlaps(const Particle& part1, const Particle& part2) const
+  bool
+  ISquareBond::checkOverlaps(const Particle& part1, const Particle& part2, 
+			     bool textoutput) const
   {
+    bool retval = false;
+
     Vector  rij = part1.getPosition() - part2.getPosition();
     Sim->dynamics.BCs().applyBC(rij);
     double r2 = rij.nrm2();
@@ -121,18 +124,28 @@ namespace dynamo {
 
 
     if (r2 < d2)
-      derr << "Possible bonded overlap occured in diagnostics\n ID1=" << part1.getID() 
-	   << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-	   << r2 / pow(Sim->dynamics.units().unitLength(),2)
-	   << "\nd^2=" 
-	   << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+      {
+	if (textoutput)
+	  derr << "Possible bonded overlap occured in diagnostics\n ID1=" << part1.getID() 
+	       << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+	       << r2 / pow(Sim->dynamics.units().unitLength(),2)
+	       << "\nd^2=" 
+	       << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	retval = true;
+      }
   
     if (r2 > ld2)
-      derr << "Possible escaped bonded pair in diagnostics\n ID1=" << part1.getID() 
-	   << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-	   << r2 / pow(Sim->dynamics.units().unitLength(),2)
-	   << "\n(lambda * d)^2=" 
-	   << ld2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+      {
+	if (textoutput)
+	  derr << "Possible escaped bonded pair in diagnostics\n ID1=" << part1.getID() 
+	       << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+	       << r2 / pow(Sim->dynamics.units().unitLength(),2)
+	       << "\n(lambda * d)^2=" 
+	       << ld2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	retval = true;
+      }
+
+    return retval;
   }
 
   IntEvent 
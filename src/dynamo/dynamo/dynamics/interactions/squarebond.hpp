@@ -50,7 +50,10 @@ namespace dynamo {
 
     virtual bool captureTest(const Particle&, const Particle&) const;
 
-    virtual void checkOverlaps(const Particle&, const Particle&) const;
+    virtual bool checkOverlaps(const Particle&, const Particle&, bool textoutput = true) const;
+
+    //! Escaped bonds can be any distance apart
+    virtual bool localOverlapChecks() const { return false; }
 
     virtual IntEvent getEvent(const Particle&, const Particle&) const;
   
@@ -98,7 +98,10 @@ namespace dynamo {
   ISquareWell::initialise(size_t nID)
   {
     ID = nID;
-    ISingleCapture::initCaptureMap(Sim->particleList);
+    _diameterValues = _diameter->getHandle();
+    _lambdaValues = _lambda->getHandle();
+    _wellDepthValues = _wellDepth->getHandle();
+    _eValues = _e->getHandle();
   }
 
   bool 
@@ -109,11 +112,11 @@ namespace dynamo {
     Vector  rij = p1.getPosition() - p2.getPosition();
     Sim->dynamics.BCs().applyBC(rij);
 
-    double d = (_diameter->getProperty(p1.getID())
-		+ _diameter->getProperty(p2.getID())) * 0.5;
+    double d = (_diameterValues[p1.getID()]
+		+ _diameterValues[p2.getID()]) * 0.5;
 
-    double l = (_lambda->getProperty(p1.getID())
-		+ _lambda->getProperty(p2.getID())) * 0.5;
+    double l = (_lambdaValues[p1.getID()]
+		+ _lambdaValues[p2.getID()]) * 0.5;
   
     double ld2 = d * l * d * l;
 
@@ -145,11 +148,11 @@ namespace dynamo {
 #endif 
 
     CPDData colldat(*Sim, p1, p2);
-    double d = (_diameter->getProperty(p1.getID())
-		+ _diameter->getProperty(p2.getID())) * 0.5;
+    double d = (_diameterValues[p1.getID()]
+		+ _diameterValues[p2.getID()]) * 0.5;
 
-    double l = (_lambda->getProperty(p1.getID())
-		+ _lambda->getProperty(p2.getID())) * 0.5;
+    double l = (_lambdaValues[p1.getID()]
+		+ _lambdaValues[p2.getID()]) * 0.5;
   
     double d2 = d * d;
     double ld2 = d * l * d * l;
@@ -212,6 +215,73 @@ namespace dynamo {
     return retval;
   }
 
+  template<class Handle>
+  void
+  ISquareWell::batchedEvents(const Particle& p1, const size_t* IDs, size_t N, 
+			     IntEvent* events, const Handle& diameter, 
+			     const Handle& lambda) const
+  {
+    const Liouvillean& liouvillean = Sim->dynamics.getLiouvillean();
+    const double diameter1 = diameter[p1.getID()];
+    const double lambda1 = lambda[p1.getID()];
+    double inner2[CPDBatch::maxSize], ld2[CPDBatch::maxSize];
+    double inDt[CPDBatch::maxSize], outDt[CPDBatch::maxSize];
+    bool captured[CPDBatch::maxSize];
+
+    for (size_t start(0); start < N; start += CPDBatch::maxSize)
+      {
+	const CPDBatch colldat(*Sim, p1, IDs + start, 
+			       std::min(N - start, CPDBatch::maxSize));
+
+	//Captured pairs test for the core, the others for the well
+	for (size_t i(0); i < colldat.size; ++i)
+	  {
+	    const size_t ID2 = IDs[start + i];
+	    double d = (diameter1 + diameter[ID2]) * 0.5;
+	    double l = (lambda1 + lambda[ID2]) * 0.5;
+	    captured[i] = isCaptured(p1, Sim->particleList[ID2]);
+	    ld2[i] = d * l * d * l;
+	    inner2[i] = captured[i] ? d * d : ld2[i];
+	  }
+
+	liouvillean.SphereSphereInRoots(colldat, inner2, inDt);
+	liouvillean.SphereSphereOutRoots(colldat, ld2, outDt);
+
+	for (size_t i(0); i < colldat.size; ++i)
+	  {
+	    const Particle& p2 = Sim->particleList[IDs[start + i]];
+	    if (captured[i] && (inDt[i] > outDt[i]))
+	      events[start + i] = IntEvent(p1, p2, outDt[i], WELL_OUT, *this);
+	    else if (inDt[i] != HUGE_VAL)
+	      events[start + i] = IntEvent(p1, p2, inDt[i], captured[i] ? CORE : WELL_IN, *this);
+	    else
+	      events[start + i] = IntEvent(p1, p2, HUGE_VAL, NONE, *this);
+	  }
+      }
+  }
+
+  void
+  ISquareWell::getEvents(const Particle& p1, const size_t* IDs, size_t N, 
+			 IntEvent* events) const
+  {
+#if !defined(DYNAMO_DEBUG) && !defined(DYNAMO_OverlapTesting)
+    if (Sim->dynamics.getLiouvillean().hasBatchedSphereRoots())
+      {
+	//Monodisperse systems have their own kernel, with constant
+	//interaction distances
+	if (_diameterValues.isConstant() && _lambdaValues.isConstant())
+	  batchedEvents(p1, IDs, N, events, ConstantPropertyHandle(_diameterValues[0]),
+			ConstantPropertyHandle(_lambdaValues[0]));
+	else
+	  batchedEvents(p1, IDs, N, events, _diameterValues, _lambdaValues);
+	return;
+      }
+#endif
+
+    //The per pair tests also check for overlaps in debug builds
+    Interaction::getEvents(p1, IDs, N, events);
+  }
+
   void
   ISquareWell::runEvent(const Particle& p1, 
 			const Particle& p2,
@@ -219,19 +289,19 @@ namespace dynamo {
   {
     ++Sim->eventCount;
 
-    double d = (_diameter->getProperty(p1.getID())
-		+ _diameter->getProperty(p2.getID())) * 0.5;
+    double d = (_diameterValues[p1.getID()]
+		+ _diameterValues[p2.getID()]) * 0.5;
     double d2 = d * d;
 
-    double e = (_e->getProperty(p1.getID())
-		+ _e->getProperty(p2.getID())) * 0.5;
+    double e = (_eValues[p1.getID()]
+		+ _eValues[p2.getID()]) * 0.5;
 
-    double l = (_lambda->getProperty(p1.getID())
-		+ _lambda->getProperty(p2.getID())) * 0.5;
+    double l = (_lambdaValues[p1.getID()]
+		+ _lambdaValues[p2.getID()]) * 0.5;
     double ld2 = d * l * d * l;
 
-    double wd = (_wellDepth->getProperty(p1.getID())
-		 + _wellDepth->getProperty(p2.getID())) * 0.5;
+    double wd = (_wellDepthValues[p1.getID()]
+		 + _wellDepthValues[p2.getID()]) * 0.5;
     switch (iEvent.getType())
       {
       case CORE:
@@ -284,9 +354,12 @@ namespace dynamo {
       } 
   }
 
-  void
-  ISquareWell::checkOverlaps(const Particle& part1, const Particle& part2) const
+  bool
+  ISquareWell::checkOverlaps(const Particle& part1, const Particle& part2, 
+			     bool textoutput) const
   {
+    bool retval = false;
+
     Vector  rij = part1.getPosition() - part2.getPosition();
     Sim->dynamics.BCs().applyBC(rij);
     double r2 = rij.nrm2();
@@ -303,35 +376,53 @@ namespace dynamo {
     if (isCaptured(part1, part2))
       {
 	if (r2 < d2)
-	  derr << "Possible captured overlap occured in diagnostics\n ID1=" << part1.getID() 
-	       << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-	       << r2 / pow(Sim->dynamics.units().unitLength(),2)
-	       << "\nd^2=" 
-	       << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	  {
+	    if (textoutput)
+	      derr << "Possible captured overlap occured in diagnostics\n ID1=" << part1.getID() 
+		   << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+		   << r2 / pow(Sim->dynamics.units().unitLength(),2)
+		   << "\nd^2=" 
+		   << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	    retval = true;
+	  }
       
 	if (r2 > ld2)
-	  derr << "Possible escaped captured pair in diagnostics\n ID1=" << part1.getID() 
-	       << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-	       << r2 / pow(Sim->dynamics.units().unitLength(),2)
-	       << "\n(lambda * d)^2=" 
-	       << ld2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	  {
+	    if (textoutput)
+	      derr << "Possible escaped captured pair in diagnostics\n ID1=" << part1.getID() 
+		   << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+		   << r2 / pow(Sim->dynamics.units().unitLength(),2)
+		   << "\n(lambda * d)^2=" 
+		   << ld2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	    retval = true;
+	  }
       }
     else 
       if (r2 < ld2)
 	{
 	  if (r2 < d2)
-	    derr << "Overlap error\n ID1=" << part1.getID() 
-		 << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-		 << r2 / pow(Sim->dynamics.units().unitLength(),2)
-		 << "\n(d)^2=" 
-		 << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	    {
+	      if (textoutput)
+		derr << "Overlap error\n ID1=" << part1.getID() 
+		     << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+		     << r2 / pow(Sim->dynamics.units().unitLength(),2)
+		     << "\n(d)^2=" 
+		     << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	      retval = true;
+	    }
 	  else
-	    derr << "Possible missed captured pair in diagnostics\n ID1=" << part1.getID() 
-		 << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-		 << r2 / pow(Sim->dynamics.units().unitLength(),2)
-		 << "\n(lambda * d)^2=" 
-		 << ld2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	    {
+	      if (textoutput)
+		derr << "Possible missed captured pair in diagnostics\n ID1=" << part1.getID() 
+		     << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+		     << r2 / pow(Sim->dynamics.units().unitLength(),2)
+		     << "\n(lambda * d)^2=" 
+		     << ld2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	      retval = true;
+	    }
 	}
+
+    return retval;
   }
   
   void 
@@ -51,13 +51,15 @@ namespace dynamo {
 
     virtual double maxIntDist() const;
 
-    virtual void checkOverlaps(const Particle&, const Particle&) const;
+    virtual bool checkOverlaps(const Particle&, const Particle&, bool textoutput = true) const;
 
     virtual bool captureTest(const Particle&, const Particle&) const;
 
     virtual void initialise(size_t);
 
     virtual IntEvent getEvent(const Particle&, const Particle&) const;
+
+    virtual void getEvents(const Particle&, const size_t*, size_t, IntEvent*) const;
   
     virtual void runEvent(const Particle&, const Particle&, const IntEvent&) const;
   
@@ -68,9 +70,21 @@ namespace dynamo {
     virtual double getInternalEnergy(const Particle&, const Particle&) const;
 
   protected:
+    //! The batched form of getEvents, instantiated for constant and
+    //! per-particle diameters and well widths.
+    template<class Handle>
+    void batchedEvents(const Particle&, const size_t*, size_t, IntEvent*, 
+		       const Handle& diameter, const Handle& lambda) const;
+
     std::tr1::shared_ptr<Property> _diameter;
     std::tr1::shared_ptr<Property> _lambda;
     std::tr1::shared_ptr<Property> _wellDepth;
     std::tr1::shared_ptr<Property> _e;
+
+    //! Handles to the values of the properties, set in initialise.
+    PropertyHandle _diameterValues;
+    PropertyHandle _lambdaValues;
+    PropertyHandle _wellDepthValues;
+    PropertyHandle _eValues;
   };
 }
@@ -120,12 +120,6 @@ namespace dynamo {
   IStepped::initialise(size_t nID)
   {
     ID = nID;
-    IMultiCapture::initCaptureMap(Sim->particleList);
-  
-    dout << "Buckets in captureMap " << captureMap.bucket_count()
-	 << "\nMax bucket count " << captureMap.max_bucket_count()
-	 << "\nload Factor " << captureMap.load_factor()
-	 << "\nMax load Factor " << captureMap.max_load_factor() << std::endl;
   }
 
   int 
@@ -259,6 +253,65 @@ namespace dynamo {
     return retval;
   }
 
+  void
+  IStepped::getEvents(const Particle& p1, const size_t* IDs, size_t N, 
+		      IntEvent* events) const
+  {
+#if !defined(DYNAMO_DEBUG) && !defined(DYNAMO_OverlapTesting)
+    const Liouvillean& liouvillean = Sim->dynamics.getLiouvillean();
+    if (liouvillean.hasBatchedSphereRoots())
+      {
+	const double unitLength = _unitLength->getMaxValue();
+	double in2[CPDBatch::maxSize], out2[CPDBatch::maxSize];
+	double inDt[CPDBatch::maxSize], outDt[CPDBatch::maxSize];
+	//The step of each pair, or -1 if the pair is not captured
+	int step[CPDBatch::maxSize];
+
+	for (size_t start(0); start < N; start += CPDBatch::maxSize)
+	  {
+	    const CPDBatch colldat(*Sim, p1, IDs + start, 
+				   std::min(N - start, CPDBatch::maxSize));
+
+	    for (size_t i(0); i < colldat.size; ++i)
+	      {
+		const const_cmap_it capstat = getCMap_it(p1, Sim->particleList[IDs[start + i]]);
+		step[i] = (capstat == captureMap.end()) ? -1 : capstat->second;
+
+		//The step to test for capture, the innermost step has
+		//nothing inside it
+		double d = steps[std::min(std::max(step[i], 0), static_cast<int>(steps.size()) - 1)].first * unitLength;
+		in2[i] = d * d;
+
+		d = steps[std::max(step[i] - 1, 0)].first * unitLength;
+		out2[i] = d * d;
+	      }
+
+	    liouvillean.SphereSphereInRoots(colldat, in2, inDt);
+	    liouvillean.SphereSphereOutRoots(colldat, out2, outDt);
+
+	    for (size_t i(0); i < colldat.size; ++i)
+	      {
+		const Particle& p2 = Sim->particleList[IDs[start + i]];
+		if (step[i] == static_cast<int>(steps.size()))
+		  inDt[i] = HUGE_VAL;
+
+		if ((step[i] > 0) && (inDt[i] > outDt[i]))
+		  events[start + i] = IntEvent(p1, p2, outDt[i], WELL_OUT, *this);
+		else if (inDt[i] != HUGE_VAL)
+		  events[start + i] = IntEvent(p1, p2, inDt[i], WELL_IN, *this);
+		else
+		  events[start + i] = IntEvent(p1, p2, HUGE_VAL, NONE, *this);
+	      }
+	  }
+
+	return;
+      }
+#endif
+
+    //The per pair tests also check for overlaps in debug builds
+    Interaction::getEvents(p1, IDs, N, events);
+  }
+
   void
   IStepped::runEvent(const Particle& p1, 
 		     const Particle& p2,
@@ -336,15 +389,25 @@ namespace dynamo {
       } 
   }
 
-  void
-  IStepped::checkOverlaps(const Particle& part1, const Particle& part2) const
+  bool
+  IStepped::checkOverlaps(const Particle& part1, const Particle& part2, 
+			  bool textoutput) const
   {
+    bool retval = false;
+
     const_cmap_it capstat = getCMap_it(part1,part2);
+    const int recorded = (capstat == captureMap.end()) ? 0 : capstat->second;
 
-    if (captureTest(part1,part2) != capstat->second)
-      derr << "Particle " << part1.getID() << " and Particle " << part2.getID()
-	   << "\nFailing as captureTest gives " << captureTest(part1,part2)
-	   << "\nAnd recorded value is " << capstat->second << std::endl;
+    if (captureTest(part1,part2) != recorded)
+      {
+	if (textoutput)
+	  derr << "Particle " << part1.getID() << " and Particle " << part2.getID()
+	       << "\nFailing as captureTest gives " << captureTest(part1,part2)
+	       << "\nAnd recorded value is " << recorded << std::endl;
+	retval = true;
+      }
+
+    return retval;
   }
   
   void 
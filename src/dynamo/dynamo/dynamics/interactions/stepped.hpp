@@ -43,13 +43,15 @@ namespace dynamo {
 
     virtual double maxIntDist() const;
 
-    virtual void checkOverlaps(const Particle&, const Particle&) const;
+    virtual bool checkOverlaps(const Particle&, const Particle&, bool textoutput = true) const;
 
     virtual int captureTest(const Particle&, const Particle&) const;
 
     virtual void initialise(size_t);
 
     virtual IntEvent getEvent(const Particle&, const Particle&) const;
+
+    virtual void getEvents(const Particle&, const size_t*, size_t, IntEvent*) const;
   
     virtual void runEvent(const Particle&, const Particle&, 
 			  const IntEvent&) const;
@@ -194,7 +194,6 @@ namespace dynamo {
   ISWSequence::initialise(size_t nID)
   {
     ID = nID;
-    ISingleCapture::initCaptureMap(Sim->particleList);
   }
 
   bool 
@@ -389,9 +388,12 @@ namespace dynamo {
       }
   }
 
-  void
-  ISWSequence::checkOverlaps(const Particle& part1, const Particle& part2) const
+  bool
+  ISWSequence::checkOverlaps(const Particle& part1, const Particle& part2, 
+			     bool textoutput) const
   {
+    bool retval = false;
+
     Vector  rij = part1.getPosition() - part2.getPosition();
     Sim->dynamics.BCs().applyBC(rij);
     double r2 = rij.nrm2();
@@ -409,37 +411,55 @@ namespace dynamo {
     if (isCaptured(part1, part2))
       {
 	if (r2 < d2)
-	  derr << "Possible captured overlap occured in diagnostics\n ID1=" << part1.getID() 
-	       << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-	       << r2 / pow(Sim->dynamics.units().unitLength(),2)
-	       << "\nd^2=" 
-	       << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	  {
+	    if (textoutput)
+	      derr << "Possible captured overlap occured in diagnostics\n ID1=" << part1.getID() 
+		   << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+		   << r2 / pow(Sim->dynamics.units().unitLength(),2)
+		   << "\nd^2=" 
+		   << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	    retval = true;
+	  }
 
 	if (r2 > ld2)
-	  derr << "Possible escaped captured pair in diagnostics\n ID1=" << part1.getID() 
-	       << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-	       << r2 / pow(Sim->dynamics.units().unitLength(),2)
-	       << "\n(lambda * d)^2=" 
-	       << ld2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	  {
+	    if (textoutput)
+	      derr << "Possible escaped captured pair in diagnostics\n ID1=" << part1.getID() 
+		   << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+		   << r2 / pow(Sim->dynamics.units().unitLength(),2)
+		   << "\n(lambda * d)^2=" 
+		   << ld2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	    retval = true;
+	  }
       }
     else 
       {
 	if (r2 < d2)
-	  derr << "Particles overlapping cores without even being captured."
-	       << "\nProbably a bad initial configuration."
-	       << "\n ID1=" 
-	       << part1.getID() 
-	       << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-	       << r2 / pow(Sim->dynamics.units().unitLength(),2)
-	       << "\nd^2=" 
-	       << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	  {
+	    if (textoutput)
+	      derr << "Particles overlapping cores without even being captured."
+		   << "\nProbably a bad initial configuration."
+		   << "\n ID1=" 
+		   << part1.getID() 
+		   << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+		   << r2 / pow(Sim->dynamics.units().unitLength(),2)
+		   << "\nd^2=" 
+		   << d2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	    retval = true;
+	  }
 	if (r2 < ld2)
-	  derr << "Possible missed captured pair in diagnostics\n ID1=" 
-	       << part1.getID() 
-	       << ", ID2=" << part2.getID() << "\nR_ij^2=" 
-	       << r2 / pow(Sim->dynamics.units().unitLength(),2)
-	       << "\n(lambda * d)^2=" 
-	       << ld2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	  {
+	    if (textoutput)
+	      derr << "Possible missed captured pair in diagnostics\n ID1=" 
+		   << part1.getID() 
+		   << ", ID2=" << part2.getID() << "\nR_ij^2=" 
+		   << r2 / pow(Sim->dynamics.units().unitLength(),2)
+		   << "\n(lambda * d)^2=" 
+		   << ld2 / pow(Sim->dynamics.units().unitLength(),2) << std::endl;
+	    retval = true;
+	  }
       }
+
+    return retval;
   }
 }
@@ -26,6 +26,8 @@ namespace dynamo {
 
     virtual bool SphereSphereInRoot(CPDData&, const double&, bool p1Dynamic, bool p2Dynamic) const;
     virtual bool SphereSphereOutRoot(CPDData&, const double&, bool p1Dynamic, bool p2Dynamic) const;  
+    //! The batched roots of LNewtonian do not apply to this Liouvillean.
+    virtual bool hasBatchedSphereRoots() const { return false; }
     virtual bool sphereOverlap(const CPDData&, const double&) const;
 
     virtual PairEventData SmoothSpheresColl(const IntEvent&, const double&, const double&, const EEventType&) const;
@@ -38,6 +38,9 @@
 #include <magnet/math/matrix.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
 
 namespace dynamo {
   bool 
@@ -135,6 +138,91 @@ namespace dynamo {
     return true;
   }
 
+  namespace {
+    //! The scalar form of LNewtonian::SphereSphereInRoot, returning
+    //! HUGE_VAL if there is no event.
+    inline double sphereSphereInRoot(double rvdot, double r2, double v2, double d2)
+    {
+      if (rvdot >= 0) return HUGE_VAL;
+      double c = r2 - d2;
+      if (c <= 0) return 0;
+      double arg = rvdot * rvdot - v2 * c;
+      if (arg < 0) return HUGE_VAL;
+      return std::max(0.0, (d2 - r2) / (rvdot - std::sqrt(arg)));
+    }
+
+    //! The scalar form of LNewtonian::SphereSphereOutRoot, returning
+    //! HUGE_VAL if there is no event.
+    inline double sphereSphereOutRoot(double rvdot, double r2, double v2, double d2)
+    {
+      if (v2 == 0) return HUGE_VAL;
+      double arg = rvdot * rvdot - v2 * (r2 - d2);
+      double dt = (arg < 0) ? - rvdot / v2 : (std::sqrt(arg) - rvdot) / v2;
+      return std::max(dt, 0.0);
+    }
+
+#ifdef __SSE2__
+    //! Returns a where mask is set, and b elsewhere.
+    inline __m128d select(__m128d mask, __m128d a, __m128d b)
+    { return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b)); }
+#endif
+  }
+
+  void
+  LNewtonian::SphereSphereInRoots(const CPDBatch& dat, const double* d2, double* dt) const
+  {
+    size_t i(0);
+#ifdef __SSE2__
+    //Two pairs are solved at once, using the same operations (and
+    //so giving the same results) as the scalar form above.
+    const __m128d zero = _mm_setzero_pd(), huge = _mm_set1_pd(HUGE_VAL);
+    for (; i + 2 <= dat.size; i += 2)
+      {
+	const __m128d rvdot = _mm_loadu_pd(dat.rvdot + i), r2 = _mm_loadu_pd(dat.r2 + i),
+	  v2 = _mm_loadu_pd(dat.v2 + i), dd = _mm_loadu_pd(d2 + i);
+
+	const __m128d c = _mm_sub_pd(r2, dd);
+	const __m128d arg = _mm_sub_pd(_mm_mul_pd(rvdot, rvdot), _mm_mul_pd(v2, c));
+	const __m128d root = _mm_max_pd(_mm_div_pd(_mm_sub_pd(dd, r2), 
+						   _mm_sub_pd(rvdot, _mm_sqrt_pd(arg))), zero);
+
+	__m128d result = select(_mm_cmplt_pd(arg, zero), huge, root);
+	result = select(_mm_cmple_pd(c, zero), zero, result);
+	result = select(_mm_cmpge_pd(rvdot, zero), huge, result);
+	_mm_storeu_pd(dt + i, result);
+      }
+#endif
+
+    for (; i < dat.size; ++i)
+      dt[i] = sphereSphereInRoot(dat.rvdot[i], dat.r2[i], dat.v2[i], d2[i]);
+  }
+
+  void
+  LNewtonian::SphereSphereOutRoots(const CPDBatch& dat, const double* d2, double* dt) const
+  {
+    size_t i(0);
+#ifdef __SSE2__
+    const __m128d zero = _mm_setzero_pd(), huge = _mm_set1_pd(HUGE_VAL), 
+      sign = _mm_set1_pd(-0.0);
+    for (; i + 2 <= dat.size; i += 2)
+      {
+	const __m128d rvdot = _mm_loadu_pd(dat.rvdot + i), r2 = _mm_loadu_pd(dat.r2 + i),
+	  v2 = _mm_loadu_pd(dat.v2 + i), dd = _mm_loadu_pd(d2 + i);
+
+	const __m128d arg = _mm_sub_pd(_mm_mul_pd(rvdot, rvdot), _mm_mul_pd(v2, _mm_sub_pd(r2, dd)));
+	const __m128d root = _mm_div_pd(_mm_sub_pd(_mm_sqrt_pd(arg), rvdot), v2);
+	const __m128d closest = _mm_div_pd(_mm_xor_pd(rvdot, sign), v2);
+
+	__m128d result = _mm_max_pd(zero, select(_mm_cmplt_pd(arg, zero), closest, root));
+	result = select(_mm_cmpeq_pd(v2, zero), huge, result);
+	_mm_storeu_pd(dt + i, result);
+      }
+#endif
+
+    for (; i < dat.size; ++i)
+      dt[i] = sphereSphereOutRoot(dat.rvdot[i], dat.r2[i], dat.v2[i], d2[i]);
+  }
+
   bool 
   LNewtonian::sphereOverlap(const CPDData& dat, const double& d2) const
   {
@@ -37,6 +37,9 @@ namespace dynamo {
     //Pair particle dynamics
     virtual bool SphereSphereInRoot(CPDData&, const double&, bool p1Dynamic, bool p2Dynamic) const;
     virtual bool SphereSphereOutRoot(CPDData&, const double&, bool p1Dynamic, bool p2Dynamic) const;  
+    virtual bool hasBatchedSphereRoots() const { return true; }
+    virtual void SphereSphereInRoots(const CPDBatch&, const double*, double*) const;
+    virtual void SphereSphereOutRoots(const CPDBatch&, const double*, double*) const;
     virtual bool sphereOverlap(const CPDData&, const double&) const;
 
     virtual bool CubeCubeInRoot(CPDData&, const double&) const;
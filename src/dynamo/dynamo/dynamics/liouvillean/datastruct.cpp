@@ -18,6 +18,9 @@
 #include <dynamo/dynamics/liouvillean/datastruct.hpp>
 #include <dynamo/dynamics/include.hpp>
 #include <boost/foreach.hpp>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
 
 namespace dynamo {
   CPDData::CPDData(const dynamo::SimData& Sim, const CRange& range1, 
@@ -64,4 +67,69 @@ namespace dynamo {
     r2 = rij.nrm2();
     v2 = vij.nrm2();
   }
+
+  const size_t CPDBatch::maxSize;
+
+  CPDBatch::CPDBatch(const dynamo::SimData& Sim, const Particle& p1, 
+		     const size_t* IDs, size_t N):
+    size(N)
+  {
+#ifdef DYNAMO_DEBUG
+    if (N > maxSize)
+      M_throw() << "Too many pairs for a CPDBatch";
+#endif
+
+    //Gather the separations into arrays, one per dimension
+    double r[NDIM][maxSize], v[NDIM][maxSize];
+    for (size_t i(0); i < N; ++i)
+      {
+	const Particle& p2 = Sim.particleList[IDs[i]];
+	Vector rij = p1.getPosition() - p2.getPosition();
+	Vector vij = p1.getVelocity() - p2.getVelocity();
+	Sim.dynamics.BCs().applyBC(rij, vij);
+
+	for (size_t iDim(0); iDim < NDIM; ++iDim)
+	  {
+	    r[iDim][i] = rij[iDim];
+	    v[iDim][i] = vij[iDim];
+	  }
+      }
+
+    //The dot products are summed in the same order as the Vector
+    //class, so the results match CPDData exactly.
+    size_t i(0);
+#ifdef __SSE2__
+    for (; i + 2 <= N; i += 2)
+      {
+	__m128d rx = _mm_loadu_pd(r[0] + i), vx = _mm_loadu_pd(v[0] + i);
+	__m128d rv = _mm_mul_pd(rx, vx), rr = _mm_mul_pd(rx, rx), vv = _mm_mul_pd(vx, vx);
+
+	for (size_t iDim(1); iDim < NDIM; ++iDim)
+	  {
+	    __m128d rd = _mm_loadu_pd(r[iDim] + i), vd = _mm_loadu_pd(v[iDim] + i);
+	    rv = _mm_add_pd(rv, _mm_mul_pd(rd, vd));
+	    rr = _mm_add_pd(rr, _mm_mul_pd(rd, rd));
+	    vv = _mm_add_pd(vv, _mm_mul_pd(vd, vd));
+	  }
+
+	_mm_storeu_pd(rvdot + i, rv);
+	_mm_storeu_pd(r2 + i, rr);
+	_mm_storeu_pd(v2 + i, vv);
+      }
+#endif
+
+    for (; i < N; ++i)
+      {
+	rvdot[i] = r[0][i] * v[0][i];
+	r2[i] = r[0][i] * r[0][i];
+	v2[i] = v[0][i] * v[0][i];
+
+	for (size_t iDim(1); iDim < NDIM; ++iDim)
+	  {
+	    rvdot[i] += r[iDim][i] * v[iDim][i];
+	    r2[i] += r[iDim][i] * r[iDim][i];
+	    v2[i] += v[iDim][i] * v[iDim][i];
+	  }
+      }
+  }
 }
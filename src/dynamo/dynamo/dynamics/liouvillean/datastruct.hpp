@@ -51,4 +51,31 @@ namespace dynamo {
     const Particle* const p1;
     const Particle* const p2;
   };
+
+  /*! \brief Pair dynamics data for a batch of pairs sharing their
+   * first particle.
+   *
+   * This holds the same data as CPDData for up to maxSize pairs, as
+   * arrays so that the Liouvillean can test all of the pairs at once
+   * (see Liouvillean::SphereSphereInRoots). The values are calculated
+   * in the same order as CPDData, so they are identical to the values
+   * of a CPDData of each pair.
+   */
+  struct CPDBatch
+  {
+    //! The maximum number of pairs in a batch.
+    static const size_t maxSize = 32;
+
+    /*! \param p1 The first particle of every pair.
+     * \param IDs The IDs of the second particles of the pairs.
+     * \param N The number of pairs, at most maxSize.
+     */
+    CPDBatch(const dynamo::SimData& Sim, const Particle& p1, 
+	     const size_t* IDs, size_t N);
+
+    size_t size;
+    double rvdot[maxSize];
+    double r2[maxSize];
+    double v2[maxSize];
+  };
 }
@@ -24,6 +24,45 @@
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 #include <boost/foreach.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <fstream>
+#include <cstring>
+#include <stdint.h>
+
+namespace {
+  //! The first bytes of a binary particle data file.
+  const char binaryMagic[8] = {'D','Y','N','A','M','O','P','D'};
+
+  //! The header of a binary particle data file, which is followed by
+  //! the arrays of particle data.
+  struct BinaryHeader
+  {
+    char magic[8];
+    uint64_t N;
+    uint64_t orientationData;
+    uint64_t propertyCount;
+  };
+
+  //! The binary files are stored little endian, these are written and
+  //! read directly so we only support little endian hosts.
+  void testEndianness()
+  {
+    const uint16_t one(1);
+    if (!*reinterpret_cast<const char*>(&one))
+      M_throw() << "Binary configuration files are only supported on little endian machines";
+  }
+
+  inline const double* readVector(const double* data, dynamo::Vector& vec)
+  {
+    for (size_t iDim(0); iDim < NDIM; ++iDim)
+      vec[iDim] = data[iDim];
+    return data + NDIM;
+  }
+
+  inline void writeVector(std::ostream& os, const dynamo::Vector& vec)
+  { os.write(reinterpret_cast<const char*>(&vec[0]), NDIM * sizeof(double)); }
+}
 
 namespace dynamo {
   magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, const Liouvillean& g)
@@ -188,6 +227,144 @@ namespace dynamo {
     XML << magnet::xml::endtag("ParticleData");
   }
 
+  void
+  Liouvillean::loadParticleBinaryData(const magnet::xml::Node& XML, 
+				      const std::string& fileName)
+  {
+    dout << "Loading Particle Data from " << fileName << std::endl;
+
+    testEndianness();
+
+    if (!boost::filesystem::exists(fileName))
+      M_throw() << "Could not find the binary particle data file " << fileName;
+
+    boost::iostreams::mapped_file_source file(fileName);
+
+    BinaryHeader header;
+    if (file.size() < sizeof(header))
+      M_throw() << "The binary particle data file " << fileName << " is truncated";
+
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, binaryMagic, sizeof(binaryMagic)))
+      M_throw() << fileName << " is not a binary particle data file";
+
+    const size_t N = header.N;
+    if (N != XML.getNode("ParticleData").getAttribute("N").as<size_t>())
+      M_throw() << "The binary particle data file " << fileName << " holds " << N
+		<< " particles, but the configuration has " 
+		<< XML.getNode("ParticleData").getAttribute("N").as<size_t>();
+
+    if (header.propertyCount != Sim->_properties.namedPropertyCount())
+      M_throw() << "The binary particle data file " << fileName << " holds " 
+		<< header.propertyCount << " particle properties, but the configuration has " 
+		<< Sim->_properties.namedPropertyCount();
+
+    const size_t vectorArrays = 2 + 2 * (header.orientationData != 0);
+    if (file.size() < sizeof(header) + sizeof(double) 
+	* N * (vectorArrays * NDIM + header.propertyCount))
+      M_throw() << "The binary particle data file " << fileName << " is truncated";
+
+    const double* pos = reinterpret_cast<const double*>(file.data() + sizeof(header));
+    const double* vel = pos + N * NDIM;
+
+    Sim->particleList.reserve(N);
+    for (size_t ID(0); ID < N; ++ID)
+      {
+	Vector position, velocity;
+	pos = readVector(pos, position);
+	vel = readVector(vel, velocity);
+	Particle part(position * Sim->dynamics.units().unitLength(), 
+		      velocity * Sim->dynamics.units().unitVelocity(), ID);
+	Sim->particleList.push_back(part);
+      }
+
+    Sim->N = Sim->particleList.size();
+
+    dout << "Particle count " << Sim->N << std::endl;
+
+    const double* data = vel;
+    if (header.orientationData)
+      {
+	orientationData.resize(N);
+	for (size_t i(0); i < N; ++i)
+	  {
+	    data = readVector(data, orientationData[i].orientation);
+
+	    double oL = orientationData[i].orientation.nrm();
+      
+	    if (!(oL > 0.0))
+	      M_throw() << "Particle ID " << i 
+			<< " orientation vector is zero!";
+      
+	    //Makes the vector a unit vector
+	    orientationData[i].orientation /= oL;
+	  }
+
+	for (size_t i(0); i < N; ++i)
+	  data = readVector(data, orientationData[i].angularVelocity);
+      }
+
+    Sim->_properties.loadParticleBinaryData(data, N);
+  }
+
+  void 
+  Liouvillean::outputParticleBinaryData(magnet::xml::XmlStream& XML, bool applyBC,
+					const std::string& fileName) const
+  {
+    testEndianness();
+
+    XML << magnet::xml::tag("ParticleData")
+	<< magnet::xml::attr("N") << Sim->N
+	<< magnet::xml::attr("BinaryFile") 
+	<< boost::filesystem::path(fileName).filename().string();
+  
+    if (hasOrientationData())
+      XML << magnet::xml::attr("OrientationData") << "Y";
+
+    XML << magnet::xml::endtag("ParticleData");
+
+    std::ofstream os(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!os)
+      M_throw() << "Could not open " << fileName << " to write the particle data";
+
+    BinaryHeader header;
+    std::memcpy(header.magic, binaryMagic, sizeof(binaryMagic));
+    header.N = Sim->N;
+    header.orientationData = hasOrientationData();
+    header.propertyCount = Sim->_properties.namedPropertyCount();
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    //The positions and velocities are stored in separate arrays, so
+    //the boundary conditions are applied in both passes
+    for (size_t pass(0); pass < 2; ++pass)
+      for (size_t i = 0; i < Sim->N; ++i)
+	{
+	  Particle tmp(Sim->particleList[i]);
+	  if (applyBC) 
+	    Sim->dynamics.BCs().applyBC(tmp.getPosition(), tmp.getVelocity());
+	  
+	  if (pass)
+	    writeVector(os, tmp.getVelocity() * (1.0 / Sim->dynamics.units().unitVelocity()));
+	  else
+	    writeVector(os, tmp.getPosition() * (1.0 / Sim->dynamics.units().unitLength()));
+	}
+
+    if (hasOrientationData())
+      {
+	BOOST_FOREACH(const rotData& rdat, orientationData)
+	  writeVector(os, rdat.orientation);
+
+	BOOST_FOREACH(const rotData& rdat, orientationData)
+	  writeVector(os, rdat.angularVelocity);
+      }
+
+    Sim->_properties.outputParticleBinaryData(os, Sim->N);
+
+    if (!os)
+      M_throw() << "Failed while writing the particle data to " << fileName;
+  }
+
   double 
   Liouvillean::getParticleKineticEnergy(const Particle& part) const
   {
@@ -236,10 +413,9 @@ namespace dynamo {
       }
     else
       {
-	double scalefactor(sqrt(scale));
-      
-	BOOST_FOREACH(Particle& part, Sim->particleList)
-	  part.getVelocity() *= scalefactor;
+	std::vector<Vector>& vels = Sim->particleList.getVelocities();
+	for (std::vector<Vector>::iterator it = vels.begin(); it != vels.end(); ++it)
+	  *it *= scalefactor;
       }
 
     BOOST_FOREACH(rotData& rdat, orientationData)
@@ -67,7 +67,8 @@ namespace dynamo {
       SimBase(tmp, "Liouvillean"),
       partPecTime(0.0),
       streamCount(0),
-      streamFreq(1)
+      streamFreq(1),
+      epochStartTimes(1, 0)
     {};
 
     virtual ~Liouvillean() {}
@@ -95,6 +96,28 @@ namespace dynamo {
      */
     void outputParticleXMLData(magnet::xml::XmlStream& XML, bool applyBC) const;
 
+    /*! \brief Loads the particle data from the binary sidecar file
+     * of a configuration file.
+     *
+     * The file is memory mapped, and holds the positions, velocities,
+     * orientation data and per-particle Property values as raw little
+     * endian arrays (see outputParticleBinaryData).
+     *
+     * \param XML The root xml::Node of the xml::Document which has the ParticleData tag within.
+     * \param fileName The path to the binary file.
+     */
+    void loadParticleBinaryData(const magnet::xml::Node& XML, const std::string& fileName);
+
+    /*! \brief Writes the ParticleData tag of a binary configuration
+     * file, and the particle data itself to a binary sidecar file.
+     *
+     * \param XML The XMLStream to write the configuration header to.
+     * \param applyBC Wether to apply the boundary conditions to the final particle positions before writing them out.
+     * \param fileName The path of the binary file to write.
+     */
+    void outputParticleBinaryData(magnet::xml::XmlStream& XML, bool applyBC,
+				  const std::string& fileName) const;
+
     /*! \brief Returns the degrees of freedom per particle.
      */
     inline size_t getParticleDOF() const { return NDIM + 2 * hasOrientationData(); }
@@ -156,6 +179,43 @@ namespace dynamo {
      */
     virtual bool SphereSphereOutRoot(CPDData&, const double&, bool p1Dynamic, bool p2Dynamic) const = 0;  
 
+    /*! \brief Returns true if this Liouvillean implements
+     * SphereSphereInRoots and SphereSphereOutRoots.
+     */
+    virtual bool hasBatchedSphereRoots() const { return false; }
+
+    /*! \brief Determines if and when the spheres of a batch of pairs
+     * will intersect.
+     *
+     * This gives the same result as calling SphereSphereInRoot for
+     * each pair.
+     *
+     * \param batch The precomputed data of the pairs.
+     *
+     * \param d2 The square of the interaction distance of each pair.
+     *
+     * \param dt The time of the event of each pair is written here,
+     * or HUGE_VAL if the pair has no event.
+     */
+    virtual void SphereSphereInRoots(const CPDBatch& batch, const double* d2, double* dt) const
+    { M_throw() << "Not Implemented"; }
+
+    /*! \brief Determines if and when the spheres of a batch of pairs
+     * will stop intersecting.
+     *
+     * This gives the same result as calling SphereSphereOutRoot for
+     * each pair.
+     *
+     * \param batch The precomputed data of the pairs.
+     *
+     * \param d2 The square of the interaction distance of each pair.
+     *
+     * \param dt The time of the event of each pair is written here,
+     * or HUGE_VAL if the pair has no event.
+     */
+    virtual void SphereSphereOutRoots(const CPDBatch& batch, const double* d2, double* dt) const
+    { M_throw() << "Not Implemented"; }
+
     /*! \brief Determines if two spheres are overlapping
      *
      * \param pd Some precomputed data about the event that is cached by
@@ -604,15 +664,16 @@ namespace dynamo {
       //May as well take this opportunity to reset the streaming
       //Note: the Replexing coordinator RELIES on this behaviour!
       BOOST_FOREACH(const Particle& part, Sim->particleList)
-	{
-	  streamParticle(const_cast<Particle&>(part), 
-			 part.getPecTime() + partPecTime);
-	
-	  const_cast<Particle&>(part).getPecTime() = 0;
-	}
+	streamParticle(const_cast<Particle&>(part), getParticleDelay(part));
+
+      std::vector<PecTime>& pecTimes 
+	= const_cast<std::vector<PecTime>&>(Sim->particleList.getPecTimes());
+      std::fill(pecTimes.begin(), pecTimes.end(), PecTime());
 
       const_cast<double&>(partPecTime) = 0;
       const_cast<size_t&>(streamCount) = 0;
+      const_cast<std::vector<long double>&>(epochStartTimes).resize(1);
+      const_cast<std::vector<double>&>(epochLengths).clear();
     }
 
     /*! \brief Free streams a particle up to the current time.
@@ -622,15 +683,15 @@ namespace dynamo {
      */
     inline void updateParticle(const Particle& part) const
     {
-      streamParticle(const_cast<Particle&>(part), 
-		     part.getPecTime() + partPecTime);
+      streamParticle(const_cast<Particle&>(part), getParticleDelay(part));
 
       const_cast<Particle&>(part).getPecTime() = -partPecTime;
+      const_cast<Particle&>(part).getPecEpoch() = epochStartTimes.size() - 1;
     }
 
     inline bool isUpToDate(const Particle& part) const
     {
-      return part.getPecTime() == -partPecTime;
+      return getParticleDelay(part) == 0;
     }
 
     /*! \brief Free streams two particles up to the current time.
@@ -653,22 +714,41 @@ namespace dynamo {
 
     inline double getParticleDelay(const Particle& part) const
     {
-      return partPecTime + part.getPecTime();
+      const size_t epoch = part.getPecEpoch();
+
+      if (epoch + 1 == epochStartTimes.size())
+	return partPecTime + part.getPecTime();
+
+      //Add the length of the epochs which have passed since the
+      //particle was last updated. The particle's own epoch is added
+      //first, so the result is exact if the particle was up to date
+      //at the end of it.
+      double delay = part.getPecTime() + epochLengths[epoch];
+
+      if (epoch + 2 != epochStartTimes.size())
+	delay += static_cast<double>(epochStartTimes.back() 
+				     - epochStartTimes[epoch + 1]);
+
+      return delay + partPecTime;
     }
 
     /*! \brief Called when the system is moved forward in time to update
      * the delayed states state.
+     *
+     * To keep the magnitude of the partPecTime bounded, a new
+     * streaming epoch is started every streamFreq events. The
+     * peculiar times of the particles are relative to the start of
+     * the epoch in which they were last updated, so no pass over the
+     * particles is required.
      */
     inline void stream(const double& dt)
     {
       partPecTime += dt;
 
-      //Keep the magnitude of the partPecTime boundedx
       if (++streamCount == streamFreq)
 	{
-	  BOOST_FOREACH(Particle& part, Sim->particleList)
-	    part.getPecTime() += partPecTime;
-
+	  epochLengths.push_back(partPecTime);
+	  epochStartTimes.push_back(epochStartTimes.back() + partPecTime);
 	  partPecTime = 0;
 	  streamCount = 0;
 	}
@@ -721,21 +801,34 @@ namespace dynamo {
      */
     inline void advanceUpdateParticle(const Particle& part, const double& dt) const
     {
-      streamParticle(const_cast<Particle&>(part), 
-		     dt + partPecTime + part.getPecTime());
+      if (part.getPecEpoch() + 1 == epochStartTimes.size())
+	streamParticle(const_cast<Particle&>(part), 
+		       dt + partPecTime + part.getPecTime());
+      else
+	streamParticle(const_cast<Particle&>(part), dt + getParticleDelay(part));
 
       const_cast<Particle&>(part).getPecTime() = - dt - partPecTime;
+      const_cast<Particle&>(part).getPecEpoch() = epochStartTimes.size() - 1;
     }
   
-    /*! \brief The time by which the delayed state differs from the actual.*/
+    /*! \brief The time by which the delayed state differs from the
+        actual, since the start of the current streaming epoch.*/
     double partPecTime;
 
-    /*! \brief How many time increments have occured since the last
-      system syncronise.*/
+    /*! \brief How many time increments have occured since the start
+      of the current streaming epoch.*/
     size_t streamCount;
 
-    /*! \brief How often the system peculiar times should be syncronised.*/
+    /*! \brief How many time increments there are in each streaming
+        epoch.*/
     size_t streamFreq;
+
+    /*! \brief The time at the start of each streaming epoch since
+        the last system syncronise.*/
+    std::vector<long double> epochStartTimes;
+
+    /*! \brief The length of each completed streaming epoch.*/
+    std::vector<double> epochLengths;
   
     /*! \brief Writes out the liouvilleans data to XML. */
     virtual void outputXML(magnet::xml::XmlStream&) const = 0;
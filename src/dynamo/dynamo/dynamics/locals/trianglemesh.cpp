@@ -21,7 +21,10 @@
 #include <dynamo/dynamics/NparticleEventData.hpp>
 #include <dynamo/dynamics/overlapFunc/CubePlane.hpp>
 #include <dynamo/dynamics/units/units.hpp>
-#include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/dynamics/globals/gcellsmorton.hpp>
+#include <dynamo/dynamics/BC/BC.hpp>
+#include <dynamo/schedulers/neighbourlist.hpp>
+#include <typeinfo>
 
 namespace dynamo {
   LTriangleMesh::LTriangleMesh(const magnet::xml::Node& XML, dynamo::SimData* tmp):
@@ -41,20 +44,37 @@ namespace dynamo {
 
     std::pair<double, size_t> tmin(HUGE_VAL, 0); //Default to no collision
 
-    for (size_t id(0); id < _elements.size(); ++id)
+    size_t cellID;
+    if (!_cellTriangles.empty()
+	&& static_cast<const GCells&>(*Sim->dynamics.getGlobals()[_NBListID])
+	.getParticleCell(part.getID(), cellID))
       {
-	std::pair<double, size_t> t = Sim->dynamics.getLiouvillean()
-	  .getSphereTriangleEvent(part,
-				  _vertices[_elements[id].get<0>()],
-				  _vertices[_elements[id].get<1>()],
-				  _vertices[_elements[id].get<2>()],
-				  diam);
-	if (t < tmin) { tmin = t; triangleid = id; }
+	//Only the triangles near the particle's cell can be reached
+	//before the particle leaves the cell, at which point this
+	//event is recalculated.
+	BOOST_FOREACH(const size_t& id, _cellTriangles[cellID])
+	  testTriangle(part, id, diam, tmin, triangleid);
       }
+    else
+      for (size_t id(0); id < _elements.size(); ++id)
+	testTriangle(part, id, diam, tmin, triangleid);
 
     return LocalEvent(part, tmin.first, WALL, *this, 8 * triangleid + tmin.second);
   }
 
+  void
+  LTriangleMesh::testTriangle(const Particle& part, size_t id, double diam,
+			      std::pair<double, size_t>& tmin, size_t& triangleid) const
+  {
+    std::pair<double, size_t> t = Sim->dynamics.getLiouvillean()
+      .getSphereTriangleEvent(part,
+			      _vertices[_elements[id].get<0>()],
+			      _vertices[_elements[id].get<1>()],
+			      _vertices[_elements[id].get<2>()],
+			      diam);
+    if (t < tmin) { tmin = t; triangleid = id; }
+  }
+
   void
   LTriangleMesh::runEvent(const Particle& part, const LocalEvent& iEvent) const
   { 
@@ -151,11 +171,115 @@ namespace dynamo {
 
   bool 
   LTriangleMesh::isInCell(const Vector & Origin, const Vector& CellDim) const
-  { return true; }
+  {
+    for (size_t id(0); id < _elements.size(); ++id)
+      if (triangleInCell(id, Origin, CellDim)) return true;
+
+    return false;
+  }
+
+  bool
+  LTriangleMesh::triangleInCell(size_t id, const Vector& Origin, const Vector& CellDim) const
+  {
+    //Expand the box by the largest particle radius
+    const double r = 0.5 * _diameter->getMaxValue();
+    const Vector lower = Origin - Vector(r, r, r);
+    const Vector dim = CellDim + Vector(2 * r, 2 * r, 2 * r);
+    const Vector center = lower + 0.5 * dim;
+
+    //Move the triangle to the periodic image nearest the box
+    const Vector& origA = _vertices[_elements[id].get<0>()];
+    Vector A = origA - center;
+    Sim->dynamics.BCs().applyBC(A);
+    A += center;
+    const Vector B = A + (_vertices[_elements[id].get<1>()] - origA);
+    const Vector C = A + (_vertices[_elements[id].get<2>()] - origA);
+
+    //Test the bounding box of the triangle
+    for (size_t iDim(0); iDim < NDIM; ++iDim)
+      if ((std::max(A[iDim], std::max(B[iDim], C[iDim])) < lower[iDim])
+	  || (std::min(A[iDim], std::min(B[iDim], C[iDim])) > lower[iDim] + dim[iDim]))
+	return false;
+
+    //Then test that the plane of the triangle passes through the box
+    const Vector normal = (B - A) ^ (C - B);
+    return dynamo::OverlapFunctions::CubePlane(lower, dim, A, normal)
+      && dynamo::OverlapFunctions::CubePlane(lower, dim, A, -normal);
+  }
 
   void 
   LTriangleMesh::initialise(size_t nID)
-  { ID = nID; }
+  {
+    ID = nID;
+    _cellTriangles.clear();
+
+    //The triangles can only be sorted into the cells if the cells
+    //are used by the scheduler to update the local events of the
+    //particles as they move between cells.
+    if (!dynamic_cast<const SNeighbourList*>(Sim->ptrScheduler.get())) return;
+
+    try {
+      _NBListID = Sim->dynamics.getGlobal("SchedulerNBList")->getID();
+    }
+    catch (std::exception&)
+      { return; }
+
+    //Derived neighbour lists (e.g., shearing cells) have a different
+    //cell layout
+    const Global& nblist = *Sim->dynamics.getGlobals()[_NBListID];
+    if (typeid(nblist) != typeid(GCells)) return;
+
+    static_cast<const GCells&>(nblist).ConnectSigReInitNotify
+      (&LTriangleMesh::rebuildCellTriangles, this);
+  }
+
+  void
+  LTriangleMesh::rebuildCellTriangles()
+  {
+    const GCells& nblist
+      = static_cast<const GCells&>(*Sim->dynamics.getGlobals()[_NBListID]);
+
+    const Vector cellDimension = nblist.getCellDimensions();
+
+    _cellTriangles.clear();
+    _cellTriangles.resize(magnet::math::MortonNumber<3>
+			  (nblist.getCellCount(0) - 1,
+			   nblist.getCellCount(1) - 1, 
+			   nblist.getCellCount(2) - 1).getMortonNum() + 1);
+
+    size_t entries(0);
+    for (size_t iDim = 0; iDim < nblist.getCellCount(0); ++iDim)
+      for (size_t jDim = 0; jDim < nblist.getCellCount(1); ++jDim)
+	for (size_t kDim = 0; kDim < nblist.getCellCount(2); ++kDim)
+	  {
+	    magnet::math::MortonNumber<3> coords(iDim, jDim, kDim);
+	    std::vector<size_t>& triangles = _cellTriangles[coords.getMortonNum()];
+	    
+	    //The same enlarged box as the neighbour list uses to
+	    //register locals
+	    Vector pos = nblist.getCellOrigin(coords);
+	    for (size_t id(0); id < _elements.size(); ++id)
+	      if (triangleInCell(id, pos - 0.0001 * cellDimension, 1.0002 * cellDimension))
+		triangles.push_back(id);
+
+	    entries += triangles.size();
+	  }
+
+    dout << "Sorted " << _elements.size() << " triangles into the cells, "
+	 << entries << " cell entries" << std::endl;
+  }
+
+  void
+  LTriangleMesh::addElement(size_t A, size_t B, size_t C)
+  {
+    if ((A >= _vertices.size()) || (B >= _vertices.size()) || (C >= _vertices.size()))
+      M_throw() << "Triangle " << _elements.size() << " has an out of range vertex ID";
+
+    if (((_vertices[B] - _vertices[A]) ^ (_vertices[C] - _vertices[B])).nrm() == 0)
+      M_throw() << "Triangle " << _elements.size() << " has a zero normal!";
+
+    _elements.push_back(TriangleElements(A, B, C));
+  }
 
   void 
   LTriangleMesh::operator<<(const magnet::xml::Node& XML)
@@ -55,6 +55,13 @@ namespace dynamo {
 
     virtual void checkOverlaps(const Particle&) const;
 
+    //! \brief Adds a vertex to the mesh and returns its index.
+    size_t addVertex(const Vector& vertex)
+    { _vertices.push_back(vertex); return _vertices.size() - 1; }
+
+    //! \brief Adds a triangle to the mesh, formed from three vertex indices.
+    void addElement(size_t A, size_t B, size_t C);
+
 #ifdef DYNAMO_visualizer
     virtual std::tr1::shared_ptr<coil::RenderObj> getCoilRenderObj() const;
     virtual void updateRenderData() const {}
@@ -74,5 +81,26 @@ namespace dynamo {
 
     std::tr1::shared_ptr<Property> _e;
     std::tr1::shared_ptr<Property> _diameter;
+
+    /*! \brief Tests if a triangle is within reach of a particle
+      inside the passed box.
+     */
+    bool triangleInCell(size_t, const Vector&, const Vector&) const;
+
+    //! \brief Tests a particle against a triangle, keeping the earliest event.
+    inline void testTriangle(const Particle&, size_t, double, 
+			     std::pair<double, size_t>&, size_t&) const;
+
+    //! \brief Sorts the triangles into the cells of the neighbour list.
+    void rebuildCellTriangles();
+
+    size_t _NBListID;
+
+    /*! \brief The triangles within reach of a particle in each cell
+      of the scheduler's neighbour list, indexed by the cell ID.
+
+      If this is empty, every triangle is tested for events.
+     */
+    std::vector<std::vector<size_t> > _cellTriangles;
   };
 }
@@ -30,6 +30,10 @@ namespace dynamo {
   
     virtual bool isInRange(const Particle&, const Particle&) const
     { return true; }
+
+    virtual Coverage getCoverage(const CRange&, const CRange&, 
+				 const dynamo::SimData*) const
+    { return ALL; }
   
     virtual void operator<<(const magnet::xml::Node&);
   
@@ -30,6 +30,10 @@ namespace dynamo {
   
     virtual bool isInRange(const Particle&, const Particle&) const
     { return false; }
+
+    virtual Coverage getCoverage(const CRange&, const CRange&, 
+				 const dynamo::SimData*) const
+    { return NONE; }
   
     virtual void operator<<(const magnet::xml::Node&);
   
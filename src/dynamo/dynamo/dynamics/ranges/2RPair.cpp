@@ -38,6 +38,16 @@ namespace dynamo {
     return false;
   }
 
+  C2Range::Coverage
+  C2RPair::getCoverage(const CRange& r1, const CRange& r2, 
+		       const dynamo::SimData* Sim) const
+  {
+    return eitherCoverage(bothCoverage(subsetCoverage(*range1, r1, Sim), 
+				       subsetCoverage(*range2, r2, Sim)),
+			  bothCoverage(subsetCoverage(*range1, r2, Sim), 
+				       subsetCoverage(*range2, r1, Sim)));
+  }
+
   void 
   C2RPair::operator<<(const magnet::xml::Node&)
   {
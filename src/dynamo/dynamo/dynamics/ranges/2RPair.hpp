@@ -29,6 +29,9 @@ namespace dynamo {
     C2RPair(CRange* r1, CRange* r2 ):range1(r1),range2(r2) {}
   
     virtual bool isInRange(const Particle&, const Particle&) const;
+
+    virtual Coverage getCoverage(const CRange&, const CRange&, 
+				 const dynamo::SimData*) const;
   
     virtual void operator<<(const magnet::xml::Node&);
   
@@ -36,6 +36,17 @@ namespace dynamo {
     return false;
   }
 
+  C2Range::Coverage
+  C2RRangeList::getCoverage(const CRange& r1, const CRange& r2, 
+			    const dynamo::SimData* Sim) const
+  {
+    Coverage retval(NONE);
+    BOOST_FOREACH(const std::tr1::shared_ptr<C2Range>& rPtr, ranges)
+      retval = eitherCoverage(retval, rPtr->getCoverage(r1, r2, Sim));
+
+    return retval;
+  }
+
   void 
   C2RRangeList::operator<<(const magnet::xml::Node& XML)
   {
@@ -30,6 +30,9 @@ namespace dynamo {
 
     virtual bool isInRange(const Particle&, const Particle&) const;
 
+    virtual Coverage getCoverage(const CRange&, const CRange&, 
+				 const dynamo::SimData*) const;
+
     void addRange(C2Range* nRange)
     { ranges.push_back(std::tr1::shared_ptr<C2Range>(nRange)); }
   
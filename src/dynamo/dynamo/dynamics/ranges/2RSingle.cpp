@@ -34,6 +34,14 @@ namespace dynamo {
     return (range->isInRange(p1) && range->isInRange(p2));
   }
 
+  C2Range::Coverage
+  C2RSingle::getCoverage(const CRange& r1, const CRange& r2, 
+			 const dynamo::SimData* Sim) const
+  {
+    return bothCoverage(subsetCoverage(*range, r1, Sim), 
+			subsetCoverage(*range, r2, Sim));
+  }
+
   void 
   C2RSingle::operator<<(const magnet::xml::Node&)
   {
@@ -29,6 +29,9 @@ namespace dynamo {
     C2RSingle(CRange* r1):range(r1) {}
   
     virtual bool isInRange(const Particle&, const Particle&) const;
+
+    virtual Coverage getCoverage(const CRange&, const CRange&, 
+				 const dynamo::SimData*) const;
   
     virtual void operator<<(const magnet::xml::Node&);
   
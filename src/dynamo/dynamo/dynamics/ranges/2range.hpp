@@ -20,6 +20,7 @@ namespace magnet { namespace xml { class Node; class XmlStream; } }
 namespace dynamo { 
   class SimData;
   class Particle;
+  class CRange;
 
   class C2Range
   {
@@ -28,6 +29,22 @@ namespace dynamo {
  
     virtual bool isInRange(const Particle&, const Particle&) const =0;  
     virtual void operator<<(const magnet::xml::Node& XML) = 0;
+
+    //! How many of the pairs formed between two sets of particles lie
+    //! in this range.
+    typedef enum { NONE, SOME, ALL } Coverage;
+
+    /*! \brief Tests which of the pairs formed between the particles
+     * of r1 and the particles of r2 are in this range.
+     *
+     * This is used to build the per-species lookup table of
+     * interactions. A range should only return ALL or NONE when it is
+     * certain, the default of SOME means that every pair must be
+     * tested individually using isInRange.
+     */
+    virtual Coverage getCoverage(const CRange& r1, const CRange& r2, 
+				 const dynamo::SimData*) const
+    { return SOME; }
   
     static C2Range* getClass(const magnet::xml::Node&, const dynamo::SimData*);
 
@@ -35,5 +52,25 @@ namespace dynamo {
 
   protected:
     virtual void outputXML(magnet::xml::XmlStream& XML) const = 0;
+
+    //! Tests how many of the IDs in particles are also in range.
+    static Coverage subsetCoverage(const CRange& range, const CRange& particles, 
+				   const dynamo::SimData*);
+
+    //! The coverage of the intersection of two sets of pairs.
+    static Coverage bothCoverage(Coverage a, Coverage b)
+    {
+      if ((a == NONE) || (b == NONE)) return NONE;
+      if ((a == ALL) && (b == ALL)) return ALL;
+      return SOME;
+    }
+
+    //! The coverage of the union of two sets of pairs.
+    static Coverage eitherCoverage(Coverage a, Coverage b)
+    {
+      if ((a == ALL) || (b == ALL)) return ALL;
+      if ((a == NONE) && (b == NONE)) return NONE;
+      return SOME;
+    }
   };
 }
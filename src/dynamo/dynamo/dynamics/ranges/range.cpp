@@ -18,6 +18,8 @@
 #include <dynamo/dynamics/ranges/include.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <dynamo/base/is_simdata.hpp>
+#include <boost/foreach.hpp>
 
 namespace dynamo {
   CRange* 
@@ -51,6 +53,19 @@ namespace dynamo {
     return XML;
   }
 
+  C2Range::Coverage
+  C2Range::subsetCoverage(const CRange& range, const CRange& particles, 
+			  const dynamo::SimData* Sim)
+  {
+    size_t count(0);
+    BOOST_FOREACH(unsigned long ID, particles)
+      if (range.isInRange(Sim->particleList[ID])) ++count;
+
+    if (!count) return NONE;
+    if (count == particles.size()) return ALL;
+    return SOME;
+  }
+
   C2Range*
   C2Range::getClass(const magnet::xml::Node& XML, const dynamo::SimData* Sim)
   {
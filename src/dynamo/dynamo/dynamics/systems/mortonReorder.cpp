@@ -0,0 +1,83 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/dynamics/systems/mortonReorder.hpp>
+#include <dynamo/base/is_simdata.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/dynamics/globals/gcellsmorton.hpp>
+#include <dynamo/dynamics/units/units.hpp>
+
+#ifdef DYNAMO_DEBUG 
+#include <boost/math/special_functions/fpclassify.hpp>
+#endif
+
+namespace dynamo {
+  SMortonReorder::SMortonReorder(dynamo::SimData* nSim, double ndt, std::string nName):
+    System(nSim),
+    periodt(ndt * nSim->dynamics.units().unitTime())
+  {
+    if (periodt <= 0)
+      M_throw() << "The Morton reordering period must be positive";
+
+    dt = periodt;
+    sysName = nName;
+
+    dout << "Periodic Morton reordering set for dt=" 
+	 << ndt << std::endl;
+  }
+
+  void 
+  SMortonReorder::runEvent() const
+  {
+    double locdt = dt;
+  
+#ifdef DYNAMO_DEBUG 
+    if (boost::math::isnan(dt))
+      M_throw() << "A NAN system event time has been found";
+#endif
+    
+    Sim->dSysTime += locdt;
+    
+    Sim->ptrScheduler->stream(locdt);
+  
+    //dynamics must be updated first
+    Sim->dynamics.stream(locdt);
+  
+    Sim->freestreamAcc += locdt;
+  
+    dt = periodt;
+
+    std::vector<size_t> order;
+    _cells->getMortonOrder(order);
+    Sim->particleList.reorder(order);
+  }
+
+  void 
+  SMortonReorder::initialise(size_t nID)
+  { 
+    ID = nID;
+
+    _cells.reset();
+    BOOST_FOREACH(const std::tr1::shared_ptr<Global>& glob, 
+		  Sim->dynamics.getGlobals())
+      if ((_cells = std::tr1::dynamic_pointer_cast<GCells>(glob)))
+	break;
+
+    if (!_cells)
+      M_throw() << "Morton reordering requires a cellular neighbour list (GCells) in the system";
+  }
+}
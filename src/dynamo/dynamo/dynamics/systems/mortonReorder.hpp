@@ -0,0 +1,52 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <dynamo/dynamics/systems/system.hpp>
+#include <tr1/memory>
+
+namespace dynamo {
+  class GCells;
+
+  /*! \brief A System Event which periodically sorts the particle
+    data into the Morton order of the neighbour list cells.
+
+    The particles of a cell and its neighbours are then close together
+    in memory, which improves the cache use of the event predictions
+    as the particles diffuse away from their initial layout. Only the
+    storage of the particle data is permuted, the particle IDs are
+    unchanged.
+   */
+  class SMortonReorder: public System
+  {
+  public:
+    SMortonReorder(dynamo::SimData*, double, std::string);
+  
+    virtual void runEvent() const;
+
+    virtual void initialise(size_t);
+
+    virtual void operator<<(const magnet::xml::Node&) {}
+
+  protected:
+    virtual void outputXML(magnet::xml::XmlStream&) const {}
+
+    double periodt;
+    std::tr1::shared_ptr<GCells> _cells;
+  };
+}
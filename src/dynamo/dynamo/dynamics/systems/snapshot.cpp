@@ -79,7 +79,7 @@ namespace dynamo {
       Ptr->eventUpdate(*this, NEventData(), locdt);
   
     std::string filename = magnet::string::search_replace("Snapshot.%i.xml.bz2", "%i", boost::lexical_cast<std::string>(_saveCounter++));
-    Sim->writeXMLfile(filename, _applyBC);
+    Sim->writeXMLfileBackground(filename, _applyBC);
   }
 
   void 
@@ -69,11 +69,24 @@ namespace dynamo {
     //This is done here as most ticker properties require it
     Sim->dynamics.getLiouvillean().updateAllParticles();
 
-    BOOST_FOREACH(std::tr1::shared_ptr<OutputPlugin>& Ptr, Sim->outputPlugins)
+    //The tickers which only read the (now up to date) particles are
+    //run together on the threads of the scheduler, if it has any
+    magnet::thread::ThreadPool& threads = Sim->ptrScheduler->getThreadPool();
+    if (threads.getThreadCount() && (_concurrentTickers.size() > 1))
       {
-	std::tr1::shared_ptr<OPTicker> ptr = std::tr1::dynamic_pointer_cast<OPTicker>(Ptr);
-	if (ptr) ptr->ticker();
+	std::vector<magnet::function::Task*> tasks;
+	BOOST_FOREACH(OPTicker* ptr, _concurrentTickers)
+	  tasks.push_back(magnet::function::Task::makeTask(&OPTicker::ticker, ptr));
+
+	threads.queueTasks(tasks);
+	threads.wait();
       }
+    else
+      BOOST_FOREACH(OPTicker* ptr, _concurrentTickers)
+	ptr->ticker();
+
+    BOOST_FOREACH(OPTicker* ptr, _serialTickers)
+      ptr->ticker();
 
     BOOST_FOREACH(std::tr1::shared_ptr<OutputPlugin>& Ptr, Sim->outputPlugins)
       Ptr->eventUpdate(*this, NEventData(), locdt);
@@ -81,7 +94,25 @@ namespace dynamo {
 
   void 
   CSTicker::initialise(size_t nID)
-  { ID = nID; }
+  { 
+    ID = nID; 
+
+    //The plugins are fixed once the simulation is initialised. When
+    //replica exchanging, the plugins are swapped along with this
+    //system event, so the list remains valid.
+    _concurrentTickers.clear();
+    _serialTickers.clear();
+    BOOST_FOREACH(std::tr1::shared_ptr<OutputPlugin>& Ptr, Sim->outputPlugins)
+      {
+	OPTicker* ptr = dynamic_cast<OPTicker*>(Ptr.get());
+	if (!ptr) continue;
+
+	if (ptr->concurrentTicker())
+	  _concurrentTickers.push_back(ptr);
+	else
+	  _serialTickers.push_back(ptr);
+      }
+  }
 
   void 
   CSTicker::setdt(double ndt)
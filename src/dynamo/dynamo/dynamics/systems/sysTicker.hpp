@@ -17,8 +17,11 @@
 
 #pragma once
 #include <dynamo/dynamics/systems/system.hpp>
+#include <vector>
 
 namespace dynamo {
+  class OPTicker;
+
   class CSTicker: public System
   {
   public:
@@ -41,5 +44,10 @@ namespace dynamo {
     virtual void outputXML(magnet::xml::XmlStream&) const {}
 
     double period;
+
+    //! The ticker plugins, split into those which can be run
+    //! concurrently (see OPTicker::concurrentTicker) and the rest.
+    std::vector<OPTicker*> _concurrentTickers;
+    std::vector<OPTicker*> _serialTickers;
   };
 }
@@ -107,6 +107,7 @@ namespace dynamo {
       "\n24: Random walk of an isolated MJ model polymer"
       "\n25: Funnel and cup simulation (with sleepy particles)"
       "\n26: Polydisperse (Gaussian) hard spheres in LEBC (shearing)"
+      "\n27: Funnel test with a triangle mesh funnel"
       ;
 
     retval.add_options()
@@ -3620,6 +3621,129 @@ namespace dynamo {
 	  Sim->ensemble.reset(new dynamo::EnsembleNVShear(Sim));
 	  break;
 	}
+      case 27:
+	{
+	  //Spheres falling through a funnel built from triangles
+	  if (vm.count("help"))
+	    {
+	      std::cout<<
+		"Mode specific options:\n"
+		"  27: Funnel test with a triangle mesh funnel\n"
+		"       --i1 : Number of rows to remove when making the cone hole [3]\n"
+		"       --i2 : Number of triangle strips around the funnel [48]\n"
+		"       --f1 : Height of the cone in particle diameters [10]\n"
+		"       --f2 : Max radius of the cone in particle diameters [7.5]\n"
+		"       --f3 : Elasticity of the particles and funnel [0.4]\n";
+	      exit(1);
+	    }
+
+	  double H = 10;
+	  if (vm.count("f1"))
+	    H = vm["f1"].as<double>();
+
+	  double R = 7.5;
+	  if (vm.count("f2"))
+	    R = vm["f2"].as<double>();
+	
+	  size_t rowskip = 3;
+	  if (vm.count("i1"))
+	    rowskip = vm["i1"].as<size_t>();	
+
+	  size_t Nphi = 48;
+	  if (vm.count("i2"))
+	    Nphi = vm["i2"].as<size_t>();
+
+	  if (Nphi < 3)
+	    M_throw() << "The funnel needs at least 3 triangle strips around it";
+
+	  double elasticity = 0.4;
+	  if (vm.count("f3"))
+	    elasticity = vm["f3"].as<double>();
+
+	  double Sv = 1.0; //Vertical spacing
+	  const double elasticV = 1.0;
+
+	  Sim->primaryCellSize = Vector(1,1,1);
+	
+	  double particleDiam = std::min(1 / (2 * R + 1), 1 / (H + 1));
+
+	  Sim->dynamics.units().setUnitLength(particleDiam);
+	  Sim->dynamics.applyBC<BCPeriodic>();
+	  Sim->dynamics.addGlobal(new GCells(Sim,"SchedulerNBList"));
+
+	  //Set up a standard simulation
+	  Sim->ptrScheduler 
+	    = std::tr1::shared_ptr<SNeighbourList>(new SNeighbourList(Sim, new CSSCBT(Sim)));
+
+	  Sim->dynamics.setLiouvillean(new LNewtonianGravity(Sim, Vector(0,-Sim->dynamics.units().unitAcceleration(),0), elasticV * Sim->dynamics.units().unitVelocity()));
+
+	  Sim->dynamics.addInteraction(new IHardSphere(Sim, particleDiam, elasticity,
+						       new C2RAll()
+						       ))->setName("Bulk");
+
+	  //The funnel is a ring of vertices for each row of spheres in
+	  //the funnel of mode 23, joined by strips of triangles.
+	  std::vector<std::pair<double, double> > rings; //(radius, height)
+	  size_t Nv = static_cast<size_t>(std::sqrt(H * H + R * R) / Sv); //Number of circles	
+	  double deltaZ = H / Nv;
+	  for (size_t circle(rowskip); circle <= Nv; ++circle)
+	    rings.push_back(std::make_pair(R * circle / Nv, circle * deltaZ));
+
+	  for (size_t circle(0); particleDiam * ((circle+1) * Sv + Nv * deltaZ - 0.5) - 0.5 < 0.4; ++circle)
+	    rings.push_back(std::make_pair(R, (circle+1) * Sv + Nv * deltaZ));
+
+	  LTriangleMesh* funnel = new LTriangleMesh(Sim, elasticity, particleDiam, "Funnel", new CRAll(Sim));
+
+	  const double stripPhi = 2 * M_PI / Nphi;
+	  for (size_t ring(0); ring < rings.size(); ++ring)
+	    for (size_t radialstep(0); radialstep < Nphi; ++radialstep)
+	      funnel->addVertex(particleDiam * Vector(rings[ring].first * std::sin(radialstep * stripPhi),
+						      rings[ring].second,
+						      rings[ring].first * std::cos(radialstep * stripPhi))
+				- Vector(0,0.5,0));
+
+	  for (size_t ring(0); ring + 1 < rings.size(); ++ring)
+	    for (size_t radialstep(0); radialstep < Nphi; ++radialstep)
+	      {
+		size_t next = (radialstep + 1) % Nphi;
+		funnel->addElement(ring * Nphi + radialstep, ring * Nphi + next, (ring + 1) * Nphi + radialstep);
+		funnel->addElement(ring * Nphi + next, (ring + 1) * Nphi + next, (ring + 1) * Nphi + radialstep);
+	      }
+
+	  Sim->dynamics.addLocal(funnel);
+
+	  //Build a list of the dynamic particles
+	  std::vector<Vector> dynamicSites;
+	  double Sr = 1.1;
+	  Sv = 1.1;
+	  for (size_t circle(0); particleDiam * ((circle+1) * Sv + Nv * deltaZ - 0.5) - 0.5 < 0.4; ++circle)
+	    for (double r(R-Sr); r > 0; r -= Sr)
+	      {
+		size_t Nr = static_cast<size_t>(M_PI / std::asin(Sr / (2 * r)));
+		double deltaPhi = 2 * M_PI / Nr;
+	      
+		for (size_t radialstep(0); radialstep < Nr; ++radialstep)
+		  dynamicSites.push_back(particleDiam * Vector(r * std::sin(radialstep * deltaPhi),
+							       (circle+1) * Sv + Nv * deltaZ,
+							       r * std::cos(radialstep * deltaPhi))
+					 - Vector(0,0.5,0));
+	      }
+
+	  Sim->dynamics.addSpecies(std::tr1::shared_ptr<Species>
+				   (new SpPoint(Sim, new CRAll(Sim), 1.0, "Bulk", 0, "Bulk")));
+
+	  unsigned long nParticles = 0;
+	  Sim->particleList.reserve(dynamicSites.size());
+	  BOOST_FOREACH(const Vector & position, dynamicSites)
+	    {
+	      Vector vel = getRandVelVec() * Sim->dynamics.units().unitVelocity();
+	      if (vel[1] > 0) vel[1] = -vel[1];//So particles don't fly out of the hopper
+	      Sim->particleList.push_back(Particle(position, vel, nParticles++));
+	    }
+
+	  Sim->ensemble.reset(new dynamo::EnsembleNVE(Sim));
+	  break;
+	}
       default:
 	M_throw() << "Did not recognise the packer mode you wanted";
       }
@@ -0,0 +1,148 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/outputplugins/0partproperty/eventprofile.hpp>
+#include <dynamo/dynamics/include.hpp>
+#include <dynamo/base/is_simdata.hpp>
+#include <magnet/xmlwriter.hpp>
+
+namespace dynamo {
+  namespace {
+    EventProfile::Counter 
+    sumCounters(const std::vector<EventProfile::Counter>& counters)
+    {
+      EventProfile::Counter sum;
+      for (size_t ID(0); ID < counters.size(); ++ID)
+	{
+	  sum.count += counters[ID].count;
+	  sum.time += counters[ID].time;
+	}
+      return sum;
+    }
+  }
+
+  OPEventProfile::OPEventProfile(const dynamo::SimData* tmp, 
+				 const magnet::xml::Node&):
+    OutputPlugin(tmp, "EventProfile"),
+    _startEventCount(0)
+  {}
+
+  void
+  OPEventProfile::initialise()
+  {
+    Sim->ptrScheduler->setProfiling(true);
+    clock_gettime(CLOCK_MONOTONIC, &_startTime);
+    _startEventCount = Sim->eventCount;
+  }
+
+  void 
+  OPEventProfile::outputCounter(magnet::xml::XmlStream& XML, const char* tagName,
+				const EventProfile::Counter& counter, double duration) const
+  {
+    XML << magnet::xml::tag(tagName)
+	<< magnet::xml::attr("Count") << counter.count
+	<< magnet::xml::attr("Time") << counter.time
+	<< magnet::xml::attr("MeanTime") 
+	<< (counter.count ? counter.time / counter.count : 0.0)
+	<< magnet::xml::attr("Fraction") << counter.time / duration;
+  }
+
+  void
+  OPEventProfile::output(magnet::xml::XmlStream& XML)
+  {
+    timespec endTime;
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    const double duration = double(endTime.tv_sec) - double(_startTime.tv_sec)
+      + 1e-9 * (double(endTime.tv_nsec) - double(_startTime.tv_nsec));
+
+    const unsigned long long events = Sim->eventCount - _startEventCount;
+
+    const EventProfile& profile(Sim->ptrScheduler->getEventProfile());
+
+    const EventProfile::Counter types[4] = 
+      { sumCounters(profile.interactions), sumCounters(profile.globals),
+	sumCounters(profile.locals), sumCounters(profile.systems) };
+    const char* typeNames[4] = { "INTERACTION", "GLOBAL", "LOCAL", "SYSTEM" };
+
+    double loopTime = profile.queue.time + profile.virtuals.time
+      + profile.interactionRejections.time + profile.localRejections.time;
+    for (size_t i(0); i < 4; ++i)
+      loopTime += types[i].time;
+
+    XML << magnet::xml::tag("EventProfile")
+	<< magnet::xml::attr("Events") << events
+	<< magnet::xml::attr("Duration") << duration
+	<< magnet::xml::attr("EventRate") << (duration > 0 ? events / duration : 0.0)
+	<< magnet::xml::attr("OtherTime") << duration - loopTime;
+
+    outputCounter(XML, "Queue", profile.queue, duration);
+    XML << magnet::xml::endtag("Queue");
+
+    outputCounter(XML, "FullUpdate", profile.fullUpdates, duration);
+    XML << magnet::xml::endtag("FullUpdate");
+
+    for (size_t i(0); i < 4; ++i)
+      {
+	outputCounter(XML, "Type", types[i], duration);
+	XML << magnet::xml::attr("Name") << typeNames[i]
+	    << magnet::xml::endtag("Type");
+      }
+
+    outputCounter(XML, "Type", profile.virtuals, duration);
+    XML << magnet::xml::attr("Name") << "VIRTUAL"
+	<< magnet::xml::endtag("Type");
+
+    outputCounter(XML, "Rejected", profile.interactionRejections, duration);
+    XML << magnet::xml::attr("Type") << "INTERACTION"
+	<< magnet::xml::endtag("Rejected");
+
+    outputCounter(XML, "Rejected", profile.localRejections, duration);
+    XML << magnet::xml::attr("Type") << "LOCAL"
+	<< magnet::xml::endtag("Rejected");
+
+    for (size_t ID(0); ID < profile.interactions.size(); ++ID)
+      {
+	outputCounter(XML, "Interaction", profile.interactions[ID], duration);
+	XML << magnet::xml::attr("Name") << Sim->dynamics.getInteractions()[ID]->getName()
+	    << magnet::xml::endtag("Interaction");
+      }
+
+    for (size_t ID(0); ID < profile.globals.size(); ++ID)
+      {
+	outputCounter(XML, "Global", profile.globals[ID], duration);
+	XML << magnet::xml::attr("Name") << Sim->dynamics.getGlobals()[ID]->getName()
+	    << magnet::xml::endtag("Global");
+      }
+
+    for (size_t ID(0); ID < profile.locals.size(); ++ID)
+      {
+	outputCounter(XML, "Local", profile.locals[ID], duration);
+	XML << magnet::xml::attr("Name") << Sim->dynamics.getLocals()[ID]->getName()
+	    << magnet::xml::endtag("Local");
+      }
+
+    for (size_t ID(0); ID < profile.systems.size(); ++ID)
+      {
+	outputCounter(XML, "System", profile.systems[ID], duration);
+	XML << magnet::xml::attr("Name") << Sim->dynamics.getSystemEvents()[ID]->getName()
+	    << magnet::xml::endtag("System");
+      }
+
+    XML << magnet::xml::endtag("EventProfile");
+  }
+}
@@ -0,0 +1,59 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/outputplugins/outputplugin.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <time.h>
+
+namespace dynamo {
+  /*! \brief Profiles where the wall clock time of the event loop is
+    spent.
+
+    This enables the EventProfile of the Scheduler, which times every
+    event by its type and by the Interaction, Local, Global or System
+    that ran it, along with the rejected events, the time spent
+    sorting the queue and the fullUpdate calls (neighbourhood
+    scans). The profile is written out with the event rate of the run
+    (as in OPMisc) and the time spent outside the event loop (e.g., in
+    the other output plugins).
+   */
+  class OPEventProfile: public OutputPlugin
+  {
+  public:
+    OPEventProfile(const dynamo::SimData*, const magnet::xml::Node&);
+
+    virtual void initialise();
+
+    virtual void eventUpdate(const IntEvent&, const PairEventData&) {}
+
+    virtual void eventUpdate(const GlobalEvent&, const NEventData&) {}
+
+    virtual void eventUpdate(const LocalEvent&, const NEventData&) {}
+
+    virtual void eventUpdate(const System&, const NEventData&, const double&) {}
+
+    virtual void output(magnet::xml::XmlStream&);
+
+  protected:
+    void outputCounter(magnet::xml::XmlStream&, const char*, 
+		       const EventProfile::Counter&, double duration) const;
+
+    timespec _startTime;
+    unsigned long long _startEventCount;
+  };
+}
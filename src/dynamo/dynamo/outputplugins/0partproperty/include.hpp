@@ -22,3 +22,4 @@
 #include <dynamo/outputplugins/0partproperty/qmga.hpp>
 #include <dynamo/outputplugins/0partproperty/intEnergyHist.hpp>
 #include <dynamo/outputplugins/0partproperty/msdOrientational.hpp>
+#include <dynamo/outputplugins/0partproperty/eventprofile.hpp>
@@ -198,6 +198,12 @@ namespace dynamo {
       return testGeneratePlugin<OPCollisionCorrelator>(Sim, XML);
     else if (!Name.compare("BoundedPQStats"))
       return testGeneratePlugin<OPBoundedQStats>(Sim, XML);
+    else if (!Name.compare("LadderQueueStats"))
+      return testGeneratePlugin<OPLadderQStats>(Sim, XML);
+    else if (!Name.compare("PELStats"))
+      return testGeneratePlugin<OPPELStats>(Sim, XML);
+    else if (!Name.compare("EventProfile"))
+      return testGeneratePlugin<OPEventProfile>(Sim, XML);
     else if (!Name.compare("MSDCorrelator"))
       return testGeneratePlugin<OPMSDCorrelator>(Sim, XML);
     else if (!Name.compare("RijVijComponents"))
@@ -0,0 +1,83 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/outputplugins/tickerproperty/PELstats.hpp>
+#include <dynamo/base/is_simdata.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <magnet/xmlwriter.hpp>
+
+namespace dynamo {
+  OPPELStats::OPPELStats(const dynamo::SimData* tmp, 
+			 const magnet::xml::Node&):
+    OPTicker(tmp,"PELStats"),
+    PELSize(1),
+    staleFraction(0.01),
+    _totalEvents(0),
+    _staleEvents(0)
+  {}
+
+  void 
+  OPPELStats::initialise()
+  { Sim->ptrScheduler->setSkipTiming(true); }
+
+  void
+  OPPELStats::ticker()
+  {
+    const CSSorter& sorter(*(Sim->ptrScheduler->getSorter()));
+    const std::vector<unsigned long>& eventCount(Sim->ptrScheduler->getEventCounts());
+
+    size_t total(0), stale(0);
+    for (size_t ID(0); ID < Sim->N; ++ID)
+      {
+	const size_t size = sorter.PELSize(ID);
+	PELSize.addVal(size);
+	total += size;
+	stale += sorter.PELStale(ID, eventCount);
+      }
+
+    if (total)
+      staleFraction.addVal(double(stale) / total);
+
+    _totalEvents += total;
+    _staleEvents += stale;
+  }
+
+  void 
+  OPPELStats::output(magnet::xml::XmlStream& XML)
+  {
+    const LazyDeletionStats& stats(Sim->ptrScheduler->getLazyDeletionStats());
+    const size_t topEvents = stats.staleEvents + stats.validEvents;
+
+    XML << magnet::xml::tag("PELStats") 
+	<< magnet::xml::attr("StaleEvents") << stats.staleEvents
+	<< magnet::xml::attr("ValidEvents") << stats.validEvents
+	<< magnet::xml::attr("StaleRatio") 
+	<< (topEvents ? double(stats.staleEvents) / topEvents : 0.0)
+	<< magnet::xml::attr("SkipTime") << stats.skipTime
+	<< magnet::xml::attr("PrunePasses") << stats.prunePasses
+	<< magnet::xml::attr("PrunedEvents") << stats.prunedEvents
+	<< magnet::xml::attr("MeanPELStaleRatio") 
+	<< (_totalEvents ? double(_staleEvents) / _totalEvents : 0.0)
+	<< magnet::xml::tag("PELSize");
+    PELSize.outputHistogram(XML,1.0);
+    XML << magnet::xml::endtag("PELSize")
+	<< magnet::xml::tag("StaleFraction");
+    staleFraction.outputHistogram(XML,1.0);
+    XML << magnet::xml::endtag("StaleFraction")
+	<< magnet::xml::endtag("PELStats");
+  }
+}
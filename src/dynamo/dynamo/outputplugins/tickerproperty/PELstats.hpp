@@ -0,0 +1,51 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/outputplugins/tickerproperty/ticker.hpp>
+#include <dynamo/datatypes/histogram.hpp>
+
+namespace dynamo {
+  /*! \brief Collects the statistics of the lazy deletion scheme of
+    the Scheduler.
+
+    The lengths of the particle event lists (PELs) and the fraction
+    of their events which are stale are sampled on each tick. The
+    counts of stale and valid events reaching the top of the queue,
+    the time spent discarding the stale ones and the PEL compaction
+    counters are written out at the end of the run.
+   */
+  class OPPELStats: public OPTicker
+  {
+  public:
+    OPPELStats(const dynamo::SimData*, const magnet::xml::Node&);
+
+    virtual void initialise();
+
+    virtual void stream(double) {};
+
+    virtual void ticker();
+
+    virtual void output(magnet::xml::XmlStream&);
+  
+  protected:
+    C1DHistogram PELSize;
+    C1DHistogram staleFraction;
+    size_t _totalEvents;
+    size_t _staleEvents;
+  };
+}
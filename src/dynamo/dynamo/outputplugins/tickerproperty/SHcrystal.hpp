@@ -30,6 +30,8 @@ namespace dynamo {
     virtual void stream(double) {}
 
     virtual void ticker();
+
+    virtual bool concurrentTicker() const { return true; }
   
     virtual void output(magnet::xml::XmlStream&);
 
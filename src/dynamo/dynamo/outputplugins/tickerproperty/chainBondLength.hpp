@@ -32,6 +32,8 @@ namespace dynamo {
 
     virtual void ticker();
 
+    virtual bool concurrentTicker() const { return true; }
+
     virtual void changeSystem(OutputPlugin*);
 
     virtual void output(magnet::xml::XmlStream&);
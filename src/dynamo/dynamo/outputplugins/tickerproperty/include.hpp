@@ -32,6 +32,8 @@
 #include <dynamo/outputplugins/tickerproperty/structureImage.hpp>
 #include <dynamo/outputplugins/tickerproperty/streamticker.hpp>
 #include <dynamo/outputplugins/tickerproperty/boundedQstats.hpp>
+#include <dynamo/outputplugins/tickerproperty/ladderQstats.hpp>
+#include <dynamo/outputplugins/tickerproperty/PELstats.hpp>
 #include <dynamo/outputplugins/tickerproperty/SHcrystal.hpp>
 #include <dynamo/outputplugins/tickerproperty/SCparameter.hpp>
 #include <dynamo/outputplugins/tickerproperty/plateMotion.hpp>
@@ -0,0 +1,89 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/outputplugins/tickerproperty/ladderQstats.hpp>
+#include <dynamo/base/is_simdata.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/schedulers/sorters/ladderQueue.hpp>
+#include <magnet/xmlwriter.hpp>
+
+namespace dynamo {
+  OPLadderQStats::OPLadderQStats(const dynamo::SimData* tmp, 
+				 const magnet::xml::Node&):
+    OPTicker(tmp,"LadderQueueStats"),
+    bottomSize(1),
+    topSize(1),
+    activeRungs(1)
+  {}
+
+  void 
+  OPLadderQStats::initialise()
+  {  
+    if (!std::tr1::dynamic_pointer_cast<CSSLadderQueueBase>(Sim->ptrScheduler->getSorter()))
+      M_throw() << "Not a ladder queue sorter!";
+  }
+
+  void
+  OPLadderQStats::ticker()
+  {
+    const CSSLadderQueueBase& sorter(dynamic_cast<const CSSLadderQueueBase&>
+				     (*(Sim->ptrScheduler->getSorter())));
+ 
+    bottomSize.addVal(sorter.bottomSize());
+    topSize.addVal(sorter.topSize());
+    activeRungs.addVal(sorter.activeRungs());
+  }
+
+  void 
+  OPLadderQStats::output(magnet::xml::XmlStream& XML)
+  {
+    const CSSLadderQueueBase& sorter(dynamic_cast<const CSSLadderQueueBase&>
+				     (*(Sim->ptrScheduler->getSorter())));
+    const LadderQueueStats& stats(sorter.getStats());
+
+    XML << magnet::xml::tag("LadderQueueStats") 
+	<< magnet::xml::attr("Epochs") << stats.epochs
+	<< magnet::xml::attr("Rebases") << stats.rebases
+	<< magnet::xml::attr("BottomInserts") << stats.bottomInserts
+	<< magnet::xml::attr("BottomOverflows") << stats.bottomOverflows
+	<< magnet::xml::attr("MaxBottomSize") << stats.maxBottomSize
+	<< magnet::xml::attr("MaxRungDepth") << stats.maxRungDepth;
+
+    for (size_t i(0); i < stats.maxRungDepth; ++i)
+      XML << magnet::xml::tag("Rung")
+	  << magnet::xml::attr("Depth") << i
+	  << magnet::xml::attr("Spawned") << stats.rungSpawns[i]
+	  << magnet::xml::attr("BucketTransfers") << stats.bucketTransfers[i]
+	  << magnet::xml::attr("EventTransfers") << stats.eventTransfers[i]
+	  << magnet::xml::attr("MeanBucketSize") 
+	  << (stats.bucketTransfers[i] 
+	      ? double(stats.eventTransfers[i]) / stats.bucketTransfers[i] 
+	      : 0.0)
+	  << magnet::xml::endtag("Rung");
+
+    XML << magnet::xml::tag("BottomSize");
+    bottomSize.outputHistogram(XML,1.0);
+    XML << magnet::xml::endtag("BottomSize")
+	<< magnet::xml::tag("TopSize");
+    topSize.outputHistogram(XML,1.0);
+    XML << magnet::xml::endtag("TopSize")
+	<< magnet::xml::tag("ActiveRungs");
+    activeRungs.outputHistogram(XML,1.0);
+    XML << magnet::xml::endtag("ActiveRungs")
+	<< magnet::xml::endtag("LadderQueueStats");
+  }
+}
@@ -37,6 +37,8 @@ namespace dynamo {
     virtual void stream(double) {}
     virtual void ticker();
 
+    virtual bool concurrentTicker() const { return true; }
+
     void accPass();
 
     std::vector<boost::circular_buffer<Vector  > > posHistory;
@@ -45,9 +45,9 @@ namespace dynamo {
   void 
   OPOverlapTest::ticker()
   {
-    for (std::vector<Particle>::const_iterator iPtr = Sim->particleList.begin();
+    for (ParticleStore::const_iterator iPtr = Sim->particleList.begin();
 	 iPtr != Sim->particleList.end(); ++iPtr)
-      for (std::vector<Particle>::const_iterator jPtr = iPtr + 1;
+      for (ParticleStore::const_iterator jPtr = iPtr + 1;
 	   jPtr != Sim->particleList.end(); ++jPtr)
 	Sim->dynamics.getInteraction(*iPtr, *jPtr)->checkOverlaps(*iPtr, *jPtr);
   }
@@ -34,6 +34,8 @@ namespace dynamo {
     virtual void stream(double) {}  
     virtual void ticker();
 
+    virtual bool concurrentTicker() const { return true; }
+
     typedef std::pair<double, double> localpair;
 
     std::list<localpair> results;
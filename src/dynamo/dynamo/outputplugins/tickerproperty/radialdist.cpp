@@ -18,17 +18,161 @@
 #include <dynamo/outputplugins/tickerproperty/radialdist.hpp>
 #include <dynamo/dynamics/include.hpp>
 #include <dynamo/dynamics/liouvillean/liouvillean.hpp>
+#include <dynamo/dynamics/BC/PBC.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 #include <boost/foreach.hpp>
+#include <cmath>
 
 namespace dynamo {
+  namespace {
+    /*! \brief The read-only state shared by all the blocks of a
+      single sample of the radial distribution.
+      
+      If the cell grid is empty, every particle is binned against
+      every other particle. Otherwise each particle is only binned
+      against the later particles in its own and the 26 surrounding
+      cells, and each pair is counted in both directions.
+     */
+    struct RadialSample
+    {
+      const dynamo::SimData* Sim;
+      double binWidth;
+      size_t length;
+      size_t nSpecies;
+      std::vector<size_t> speciesID;
+
+      size_t nCells[NDIM];
+      std::vector<long> cellHead;
+      std::vector<long> cellNext;
+      std::vector<size_t> particleCell;
+
+      void buildCells(double minWidth)
+      {
+	size_t total = 1;
+	for (size_t iDim(0); iDim < NDIM; ++iDim)
+	  {
+	    nCells[iDim] = static_cast<size_t>
+	      (Sim->primaryCellSize[iDim] / minWidth);
+	    total *= nCells[iDim];
+	  }
+	
+	cellHead.assign(total, -1);
+	cellNext.resize(Sim->N);
+	particleCell.resize(Sim->N);
+
+	BOOST_FOREACH(const Particle& part, Sim->particleList)
+	  {
+	    Vector pos = part.getPosition();
+	    Sim->dynamics.BCs().applyBC(pos);
+	    
+	    size_t cell = 0;
+	    for (size_t iDim(NDIM); iDim != 0; --iDim)
+	      {
+		long coord = static_cast<long>
+		  (std::floor((pos[iDim - 1] / Sim->primaryCellSize[iDim - 1] + 0.5) 
+			      * nCells[iDim - 1]));
+		
+		//Rounding can place a particle on the far edge of the box
+		coord = std::max(0l, std::min(coord, long(nCells[iDim - 1]) - 1));
+		cell = cell * nCells[iDim - 1] + coord;
+	      }
+
+	    particleCell[part.getID()] = cell;
+	    cellNext[part.getID()] = cellHead[cell];
+	    cellHead[cell] = part.getID();
+	  }
+      }
+
+      //! Returns the bin of the pair, or length if it is out of range
+      size_t getBin(size_t p1, size_t p2) const
+      {
+	Vector rij = Sim->particleList[p1].getPosition()
+	  - Sim->particleList[p2].getPosition();
+	
+	Sim->dynamics.BCs().applyBC(rij);
+
+	return (long) (((rij.nrm()) / binWidth) + 0.5);
+      }
+    };
+
+    struct RadialBlock
+    {
+      RadialBlock(const RadialSample* sample_in, size_t start_in, size_t end_in):
+	sample(sample_in), start(start_in), end(end_in)
+      {}
+
+      void run()
+      {
+	const size_t length = sample->length;
+	const size_t nSpecies = sample->nSpecies;
+	data.assign(nSpecies * nSpecies * length, 0);
+
+	if (sample->cellHead.empty())
+	  {
+	    for (size_t p1(start); p1 < end; ++p1)
+	      for (size_t p2(0); p2 < sample->Sim->N; ++p2)
+		{
+		  size_t i = sample->getBin(p1, p2);
+		  if (i < length)
+		    ++data[(sample->speciesID[p1] * nSpecies 
+			    + sample->speciesID[p2]) * length + i];
+		}
+	    return;
+	  }
+
+	//This plugin is restricted to three dimensions
+	const size_t* nCells = sample->nCells;
+	for (size_t p1(start); p1 < end; ++p1)
+	  {
+	    const size_t s1 = sample->speciesID[p1];
+	    //The particle's correlation with itself
+	    ++data[(s1 * nSpecies + s1) * length];
+
+	    size_t cell = sample->particleCell[p1];
+	    const long x = cell % nCells[0];
+	    const long y = (cell / nCells[0]) % nCells[1];
+	    const long z = cell / (nCells[0] * nCells[1]);
+
+	    for (long dz(-1); dz <= 1; ++dz)
+	      for (long dy(-1); dy <= 1; ++dy)
+		for (long dx(-1); dx <= 1; ++dx)
+		  {
+		    size_t nb = ((x + dx + nCells[0]) % nCells[0])
+		      + nCells[0] * (((y + dy + nCells[1]) % nCells[1])
+				     + nCells[1] * ((z + dz + nCells[2]) % nCells[2]));
+		    
+		    for (long p2(sample->cellHead[nb]); p2 != -1; 
+			 p2 = sample->cellNext[p2])
+		      if (size_t(p2) > p1)
+			{
+			  size_t i = sample->getBin(p1, p2);
+			  if (i < length)
+			    {
+			      const size_t s2 = sample->speciesID[p2];
+			      ++data[(s1 * nSpecies + s2) * length + i];
+			      ++data[(s2 * nSpecies + s1) * length + i];
+			    }
+			}
+		  }
+	  }
+      }
+
+      const RadialSample* sample;
+      size_t start;
+      size_t end;
+      std::vector<unsigned long> data;
+    };
+  }
+
   OPRadialDistribution::OPRadialDistribution(const dynamo::SimData* tmp, 
 					     const magnet::xml::Node& XML):
     OPTicker(tmp,"RadialDistribution"),
     binWidth(0.1),
     length(100),
-    sampleCount(0)
+    sampleCount(0),
+    useCells(false)
   { 
     if (NDIM != 3)
       M_throw() << "This plugin will not work as I've not correctly calculated "
@@ -80,6 +224,20 @@ namespace dynamo {
 	std::vector<unsigned long>(length, 0))
        );
 
+    //Only the pairs closer than the last bin are sampled, so if at
+    //least three cells of this width fit in each direction of a
+    //periodic box, only the neighbouring cells need to be searched
+    const double maxDist = length * binWidth;
+    useCells = (dynamic_cast<const BCPeriodic*>(&Sim->dynamics.BCs()) != NULL);
+    for (size_t iDim(0); iDim < NDIM; ++iDim)
+      useCells = useCells && (Sim->primaryCellSize[iDim] >= 3 * maxDist);
+
+    if (useCells)
+      dout << "Sampling pairs using a cell grid" << std::endl;
+    else
+      dout << "Sampling all pairs, the box is too small or not periodic"
+	" for a cell grid" << std::endl;
+
     ticker();
   }
 
@@ -87,22 +245,50 @@ namespace dynamo {
   OPRadialDistribution::ticker()
   {
     ++sampleCount;
-  
-    BOOST_FOREACH(const std::tr1::shared_ptr<Species>& sp1, Sim->dynamics.getSpecies())
-      BOOST_FOREACH(const std::tr1::shared_ptr<Species>& sp2, Sim->dynamics.getSpecies())
-      { BOOST_FOREACH(const size_t& p1, *sp1->getRange())
-	  BOOST_FOREACH(const size_t& p2, *sp2->getRange())
-	  {
-	    Vector  rij = Sim->particleList[p1].getPosition()
-	      - Sim->particleList[p2].getPosition();
 
-	    Sim->dynamics.BCs().applyBC(rij);
+    RadialSample sample;
+    sample.Sim = Sim;
+    sample.binWidth = binWidth;
+    sample.length = length;
+    sample.nSpecies = Sim->dynamics.getSpecies().size();
+    sample.speciesID.resize(Sim->N);
+    BOOST_FOREACH(const std::tr1::shared_ptr<Species>& sp, Sim->dynamics.getSpecies())
+      BOOST_FOREACH(const size_t& ID, *sp->getRange())
+      sample.speciesID[ID] = sp->getID();
+
+    if (useCells)
+      sample.buildCells(length * binWidth);
 
-	    size_t i = (long) (((rij.nrm())/binWidth) + 0.5);
+    size_t nThreads = 0;
+    if (Sim->ptrScheduler)
+      nThreads = Sim->ptrScheduler->getThreadPool().getThreadCount();
+
+    //Each block fills its own histogram, which are summed at the end
+    const size_t nBlocks = std::max(size_t(1), 8 * nThreads);
+    std::vector<RadialBlock> blocks;
+    blocks.reserve(nBlocks);
+    for (size_t i(0); i < nBlocks; ++i)
+      blocks.push_back(RadialBlock(&sample, (Sim->N * i) / nBlocks, 
+				   (Sim->N * (i + 1)) / nBlocks));
+
+    if (nThreads)
+      {
+	std::vector<magnet::function::Task*> tasks;
+	for (size_t i(0); i < nBlocks; ++i)
+	  tasks.push_back(magnet::function::Task::makeTask(&RadialBlock::run, &blocks[i]));
+
+	Sim->ptrScheduler->getThreadPool().queueTasks(tasks);
+	Sim->ptrScheduler->getThreadPool().wait();
+      }
+    else
+      blocks[0].run();
 
-	    if (i < length)
-	      ++data[sp1->getID()][sp2->getID()][i];
-	  }}
+    BOOST_FOREACH(const RadialBlock& block, blocks)
+      for (size_t s1(0); s1 < sample.nSpecies; ++s1)
+	for (size_t s2(0); s2 < sample.nSpecies; ++s2)
+	  for (size_t i(0); i < length; ++i)
+	    data[s1][s2][i] 
+	      += block.data[(s1 * sample.nSpecies + s2) * length + i];
   }
 
   void
@@ -41,6 +41,8 @@ namespace dynamo {
     double binWidth;
     size_t length;
     unsigned long sampleCount;  
+    //! Set if only the pairs in neighbouring cells need to be binned
+    bool useCells;
     std::vector<std::vector<std::vector<unsigned long> > > data;
   };
 }
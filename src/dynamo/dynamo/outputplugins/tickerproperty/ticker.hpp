@@ -40,6 +40,16 @@ namespace dynamo {
     virtual void output(magnet::xml::XmlStream&) {}
 
     virtual void ticker() = 0;
+
+    /*! \brief If this ticker only reads the simulation state (and
+     * writes only to its own members) it may be run concurrently
+     * with the other such tickers.
+     *
+     * Concurrent tickers are run on the threads of the Scheduler
+     * (see CSTicker::runEvent), so they must not use those threads
+     * themselves.
+     */
+    virtual bool concurrentTicker() const { return false; }
   
     virtual void periodicOutput() {}
 
@@ -29,6 +29,8 @@ namespace dynamo {
 
     virtual void ticker();
 
+    virtual bool concurrentTicker() const { return true; }
+
     virtual void output(magnet::xml::XmlStream&);
 
     void operator<<(const magnet::xml::Node&);
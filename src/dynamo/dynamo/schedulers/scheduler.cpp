@@ -33,15 +33,45 @@
 
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <magnet/containers/small_vector.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
+#include <ctime>
 
 namespace dynamo {
+  namespace {
+    //! The number of interaction events calculated together in
+    //! Scheduler::addInteractionEvents.
+    const size_t eventBatchSize = 32;
+
+    //! Adds the time since start to the counter, and moves start on
+    //! to the current time.
+    inline void profileTick(EventProfile::Counter& counter, timespec& start)
+    {
+      timespec now;
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      counter.time += double(now.tv_sec) - double(start.tv_sec)
+	+ 1e-9 * (double(now.tv_nsec) - double(start.tv_nsec));
+      ++counter.count;
+      start = now;
+    }
+
+    inline EventProfile::Counter& 
+    profileCounter(std::vector<EventProfile::Counter>& counters, size_t ID)
+    {
+      if (ID >= counters.size()) counters.resize(ID + 1);
+      return counters[ID];
+    }
+  }
+
   Scheduler::Scheduler(dynamo::SimData* const tmp, const char * aName,
 			 CSSorter* nS):
     SimBase(tmp, aName),
     sorter(nS),
     _interactionRejectionCounter(0),
-    _localRejectionCounter(0)
+    _localRejectionCounter(0),
+    _pruneThreshold(0),
+    _skipTiming(false),
+    _profiling(false)
   {}
 
   Scheduler::~Scheduler() {}
@@ -68,8 +98,29 @@ namespace dynamo {
     eventCount.clear();
     eventCount.resize(Sim->N+1, 0);
 
-    BOOST_FOREACH(const Particle& part, Sim->particleList)
-      addEvents(part);
+    if (_threads.getThreadCount())
+      {
+	BOOST_FOREACH(const Particle& part, Sim->particleList)
+	  Sim->dynamics.getLiouvillean().updateParticle(part);
+
+	//Use several blocks per thread to even out the load
+	const size_t nBlocks = 8 * _threads.getThreadCount();
+	std::vector<magnet::function::Task*> tasks;
+	for (size_t i(0); i < nBlocks; ++i)
+	  {
+	    size_t start = (Sim->N * i) / nBlocks;
+	    size_t end = (Sim->N * (i + 1)) / nBlocks;
+	    if (start != end)
+	      tasks.push_back(magnet::function::Task::makeTask
+			      (&Scheduler::addEventsBlock, this, start, end));
+	  }
+
+	_threads.queueTasks(tasks);
+	_threads.wait();
+      }
+    else
+      BOOST_FOREACH(const Particle& part, Sim->particleList)
+	addEvents(part);
   
     sorter->init();
 
@@ -82,6 +133,33 @@ namespace dynamo {
   {  
     Sim->dynamics.getLiouvillean().updateParticle(part);
 
+    predictEvents(part, false);
+  }
+
+  void 
+  Scheduler::addEventsBlock(size_t start, size_t end) const
+  {
+    for (size_t ID(start); ID < end; ++ID)
+      predictEvents(Sim->particleList[ID], true);
+  }
+
+  namespace {
+    //! Collects the IDs of the neighbours of a particle.
+    struct NeighbourGather
+    {
+      NeighbourGather(size_t ID): _ID(ID) {}
+
+      void add(const Particle&, const size_t& ID)
+      { if (ID != _ID) IDs.push_back(ID); }
+
+      const size_t _ID;
+      magnet::containers::SmallVector<size_t, 256> IDs;
+    };
+  }
+
+  void 
+  Scheduler::predictEvents(const Particle& part, bool neighboursUpToDate) const
+  {
     //Add the global events
     BOOST_FOREACH(const std::tr1::shared_ptr<Global>& glob, Sim->dynamics.getGlobals())
       if (glob->isInteraction(part))
@@ -91,9 +169,48 @@ namespace dynamo {
     getLocalNeighbourhood
       (part, magnet::function::MakeDelegate(this, &Scheduler::addLocalEvent));
 
-    //Add the interaction events
-    getParticleNeighbourhood
-      (part, magnet::function::MakeDelegate(this, &Scheduler::addInteractionEvent));
+    //Add the interaction events. The neighbours are collected first
+    //so that the Interaction -s can test them together.
+    NeighbourGather neighbours(part.getID());
+    getParticleNeighbourhood(part, magnet::function::MakeDelegate(&neighbours, &NeighbourGather::add));
+
+    if (!neighboursUpToDate)
+      BOOST_FOREACH(const size_t& ID, neighbours.IDs)
+	Sim->dynamics.getLiouvillean().updateParticle(Sim->particleList[ID]);
+
+    addInteractionEvents(part, neighbours.IDs.begin(), neighbours.IDs.size());
+  }
+
+  void 
+  Scheduler::addInteractionEvents(const Particle& part, const size_t* IDs, size_t N) const
+  {
+    IntEvent events[eventBatchSize];
+
+    for (size_t start(0); start < N; start += eventBatchSize)
+      {
+	const size_t end = std::min(N, start + eventBatchSize);
+
+	//Pass on each run of pairs which use the same Interaction
+	size_t runStart(start);
+	const Interaction* runInteraction 
+	  = Sim->dynamics.getInteraction(part, Sim->particleList[IDs[start]]).get();
+
+	for (size_t i(start + 1); i <= end; ++i)
+	  {
+	    const Interaction* interaction = (i == end) ? NULL
+	      : Sim->dynamics.getInteraction(part, Sim->particleList[IDs[i]]).get();
+
+	    if (interaction == runInteraction) continue;
+
+	    runInteraction->getEvents(part, IDs + runStart, i - runStart, events + runStart - start);
+	    runStart = i;
+	    runInteraction = interaction;
+	  }
+
+	for (size_t i(start); i < end; ++i)
+	  if (events[i - start].getType() != NONE)
+	    sorter->push(intPart(events[i - start], eventCount[IDs[i]]), part.getID());
+      }
   }
 
   Scheduler* 
@@ -161,6 +278,10 @@ namespace dynamo {
   void
   Scheduler::runNextEvent()
   {
+    timespec profileStart;
+    if (_profiling)
+      clock_gettime(CLOCK_MONOTONIC, &profileStart);
+
     sorter->sort();
 
 #ifdef DYNAMO_DEBUG
@@ -168,6 +289,17 @@ namespace dynamo {
       M_throw() << "Next particle list is empty but top of list!";
 #endif
 
+    //Compact the PELs if too many stale events are reaching the top
+    if ((_pruneThreshold > 0)
+	&& (_lazyStats.windowStale + _lazyStats.windowValid >= eventCount.size()))
+      {
+	if (_lazyStats.windowStale 
+	    > _pruneThreshold * (_lazyStats.windowStale + _lazyStats.windowValid))
+	  prunePELs();
+
+	_lazyStats.windowStale = _lazyStats.windowValid = 0;
+      }
+
     lazyDeletionCleanup();
 
     if (boost::math::isnan(sorter->next_dt()))
@@ -231,6 +363,9 @@ namespace dynamo {
     */
     const size_t rejectionLimit = 10;
 
+    if (_profiling)
+      profileTick(_profile.queue, profileStart);
+
     switch (sorter->next_type())
       {
       case INTERACTION:
@@ -263,6 +398,9 @@ namespace dynamo {
 		   << ",p1=" << p1.getID() << ",p2=" << p2.getID() << std::endl;
 #endif		
 	      this->fullUpdate(p1, p2);
+
+	      if (_profiling)
+		profileTick(_profile.interactionRejections, profileStart);
 	      return;
 	    }
 	
@@ -308,6 +446,9 @@ namespace dynamo {
 	  Sim->dynamics.getInteractions()[Event.getInteractionID()]
 	    ->runEvent(p1,p2,Event);
 
+	  if (_profiling)
+	    profileTick(profileCounter(_profile.interactions, Event.getInteractionID()),
+			profileStart);
 	  break;
 	}
       case GLOBAL:
@@ -316,8 +457,12 @@ namespace dynamo {
 	  //optimise this (they dont need it).
 
 	  //We also don't recheck Global events! (Check, some events might rely on this behavior)
-	  Sim->dynamics.getGlobals()[sorter->next_p2()]
+	  const size_t globalID = sorter->next_p2();
+	  Sim->dynamics.getGlobals()[globalID]
 	    ->runEvent(Sim->particleList[sorter->next_ID()], sorter->next_dt());       	
+
+	  if (_profiling)
+	    profileTick(profileCounter(_profile.globals, globalID), profileStart);
 	  break;	           
 	}
       case LOCAL:
@@ -343,6 +488,9 @@ namespace dynamo {
 		   << "] (possible glancing/tenuous event canceled due to numerical error)" << std::endl;
 #endif		
 	      this->fullUpdate(part);
+
+	      if (_profiling)
+		profileTick(_profile.localRejections, profileStart);
 	      return;
 	    }
 	
@@ -354,6 +502,9 @@ namespace dynamo {
 	      derr << "Recalculated LOCAL event time is greater than the next event time, recalculating" << std::endl;
 #endif
 	      this->fullUpdate(part);
+
+	      if (_profiling)
+		profileTick(_profile.localRejections, profileStart);
 	      return;
 	    }
 
@@ -380,14 +531,21 @@ namespace dynamo {
 	  Sim->freestreamAcc = 0;
 
 	  Sim->dynamics.getLocals()[localID]->runEvent(part, iEvent);	  
+
+	  if (_profiling)
+	    profileTick(profileCounter(_profile.locals, localID), profileStart);
 	  break;
 	}
       case SYSTEM:
 	{
-	  Sim->dynamics.getSystemEvents()[sorter->next_p2()]
+	  const size_t systemID = sorter->next_p2();
+	  Sim->dynamics.getSystemEvents()[systemID]
 	    ->runEvent();
 	  //This saves the system events rebuilding themselves
 	  rebuildSystemEvents();
+
+	  if (_profiling)
+	    profileTick(profileCounter(_profile.systems, systemID), profileStart);
 	  break;
 	}
       case VIRTUAL:
@@ -398,6 +556,9 @@ namespace dynamo {
 	  //derr << "VIRTUAL for " << sorter->next_ID() << std::endl;
 
 	  this->fullUpdate(Sim->particleList[sorter->next_ID()]);
+
+	  if (_profiling)
+	    profileTick(_profile.virtuals, profileStart);
 	  break;
 	}
       case NONE:
@@ -418,11 +579,19 @@ namespace dynamo {
 				  const size_t& id) const
   {
     if (part.getID() == id) return;
-    const Particle& part2(Sim->particleList[id]);
 
-    Sim->dynamics.getLiouvillean().updateParticle(part2);
+    Sim->dynamics.getLiouvillean().updateParticle(Sim->particleList[id]);
+
+    addUpdatedInteractionEvent(part, id);
+  }
+
+  void 
+  Scheduler::addUpdatedInteractionEvent(const Particle& part, 
+					const size_t& id) const
+  {
+    if (part.getID() == id) return;
 
-    const IntEvent& eevent(Sim->dynamics.getEvent(part, part2));
+    const IntEvent& eevent(Sim->dynamics.getEvent(part, Sim->particleList[id]));
 
     if (eevent.getType() != NONE)
       sorter->push(intPart(eevent, eventCount[id]), part.getID());
@@ -471,22 +640,65 @@ namespace dynamo {
       sorter->push(Sim->dynamics.getLocals()[id]->getEvent(part), part.getID());  
   }
 
+  void
+  Scheduler::profiledFullUpdate(const Particle& part)
+  {
+    timespec startTime;
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+    invalidateEvents(part);
+    addEvents(part);
+    sort(part);
+
+    profileTick(_profile.fullUpdates, startTime);
+  }
+
   void 
   Scheduler::lazyDeletionCleanup()
   {
-    while ((sorter->next_type() == INTERACTION)
-	   && (sorter->next_collCounter2()
-	       != eventCount[sorter->next_p2()]))
+    if (staleNextEvent())
       {
-	//Not valid, update the list
-	sorter->popNextEvent();
-	sorter->update(sorter->next_ID());
-	sorter->sort();
+	timespec startTime;
+	if (_skipTiming)
+	  clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+	do
+	  {
+	    ++_lazyStats.staleEvents;
+	    ++_lazyStats.windowStale;
+
+	    //Not valid, update the list
+	    sorter->popNextEvent();
+	    sorter->update(sorter->next_ID());
+	    sorter->sort();
       
 #ifdef DYNAMO_DEBUG
-	if (sorter->nextPELEmpty())
-	  M_throw() << "Next particle list is empty but top of list!";
+	    if (sorter->nextPELEmpty())
+	      M_throw() << "Next particle list is empty but top of list!";
 #endif
+	  }
+	while (staleNextEvent());
+
+	if (_skipTiming)
+	  {
+	    timespec endTime;
+	    clock_gettime(CLOCK_MONOTONIC, &endTime);
+	    _lazyStats.skipTime += double(endTime.tv_sec) - double(startTime.tv_sec)
+	      + 1e-9 * (double(endTime.tv_nsec) - double(startTime.tv_nsec));
+	  }
+      }
+
+    if (sorter->next_type() == INTERACTION)
+      {
+	++_lazyStats.validEvents;
+	++_lazyStats.windowValid;
       }
   }
+
+  void
+  Scheduler::prunePELs()
+  {
+    ++_lazyStats.prunePasses;
+    _lazyStats.prunedEvents += sorter->prune(eventCount);
+  }
 }
@@ -21,6 +21,7 @@
 #include <dynamo/dynamics/interactions/intEvent.hpp>
 #include <dynamo/dynamics/globals/globEvent.hpp>
 #include <magnet/function/delegate.hpp>
+#include <magnet/thread/threadpool.hpp>
 #include <vector>
 
 namespace magnet { namespace xml { class Node; } }
@@ -29,6 +30,70 @@ namespace dynamo {
   class Particle;
   class intPart;
 
+  /*! \brief The counters of the lazy deletion scheme of the
+    Scheduler.
+   */
+  struct LazyDeletionStats
+  {
+    LazyDeletionStats():
+      staleEvents(0),
+      validEvents(0),
+      prunePasses(0),
+      prunedEvents(0),
+      skipTime(0),
+      windowStale(0),
+      windowValid(0)
+    {}
+
+    //! Stale interaction events discarded from the top of the queue.
+    size_t staleEvents;
+    //! Valid interaction events found at the top of the queue.
+    size_t validEvents;
+    //! Number of compaction passes over the PELs.
+    size_t prunePasses;
+    //! Stale events removed by the compaction passes.
+    size_t prunedEvents;
+    //! Wall clock time spent discarding stale events (only
+    //! collected if enabled with Scheduler::setSkipTiming).
+    double skipTime;
+    //! The stale and valid events since the last compaction check.
+    size_t windowStale, windowValid;
+  };
+
+  /*! \brief The wall clock time spent in each part of the event
+    loop of the Scheduler.
+
+    Only collected if enabled with Scheduler::setProfiling. The
+    executed events are counted against the Interaction, Local,
+    Global or System which ran them, indexed by its ID. The time of an
+    event includes the fullUpdate calls it makes, so the fullUpdate
+    counter overlaps the event counters.
+   */
+  struct EventProfile
+  {
+    struct Counter
+    {
+      Counter(): count(0), time(0) {}
+
+      size_t count;
+      double time;
+    };
+
+    //! Sorting the queue and discarding stale events before each
+    //! event is dispatched.
+    Counter queue;
+    //! Executed events of each Interaction, Local, Global and System.
+    std::vector<Counter> interactions, locals, globals, systems;
+    //! VIRTUAL events.
+    Counter virtuals;
+    //! Interaction and local events rejected after being
+    //! recalculated, including the fullUpdate of their particles.
+    Counter interactionRejections, localRejections;
+    //! Recalculating the events of a particle (the neighbourhood
+    //! scans).
+    Counter fullUpdates;
+  };
+
   class Scheduler: public dynamo::SimBase
   {
   public:
@@ -38,12 +103,55 @@ namespace dynamo {
 
     virtual void initialise();
 
+    /*! \brief Clears the sorter and predicts the events of every
+     * particle.
+     *
+     * If the scheduler has been given threads (see setThreadCount),
+     * the event prediction is shared out between them. The particles
+     * are all brought up to date first, so the threads only read the
+     * particle data and each one fills the PELs of its own block of
+     * particles.
+     */
     void rebuildList();
+
+    //! Sets the number of threads used to rebuild the event list.
+    void setThreadCount(size_t n) { _threads.setThreadCount(n); }
+
+    //! Returns the threads used to rebuild the event list, these are
+    //! also used by other start-up work (e.g., building capture maps).
+    magnet::thread::ThreadPool& getThreadPool() { return _threads; }
+
+    /*! \brief Sets the fraction of stale events at the top of the
+     * queue above which the PELs are compacted.
+     *
+     * The fraction is checked every N interaction events, and if it
+     * is exceeded every stale event is pruned from the PELs (see
+     * prunePELs). A threshold of zero disables the compaction.
+     */
+    void setPruneThreshold(double threshold) { _pruneThreshold = threshold; }
+
+    //! Removes all the stale interaction events from the PELs.
+    void prunePELs();
+
+    //! Enables timing the discarding of stale events.
+    void setSkipTiming(bool enable) { _skipTiming = enable; }
+
+    const LazyDeletionStats& getLazyDeletionStats() const { return _lazyStats; }
+
+    //! Enables (and resets) the EventProfile timing of the event loop.
+    void setProfiling(bool enable) { _profiling = enable; _profile = EventProfile(); }
+
+    const EventProfile& getEventProfile() const { return _profile; }
+
+    //! The event count of each particle, used to detect stale events.
+    const std::vector<unsigned long>& getEventCounts() const { return eventCount; }
   
     /*! \brief Retest for events for a single particle.
      */
     void fullUpdate(const Particle& part)
     {
+      if (_profiling) { profiledFullUpdate(part); return; }
+
       invalidateEvents(part);
       addEvents(part);
       sort(part);
@@ -97,6 +205,11 @@ namespace dynamo {
 
     void addInteractionEvent(const Particle&, const size_t&) const;
 
+    /*! \brief As addInteractionEvent, but assumes the second
+     * particle is already up to date.
+     */
+    void addUpdatedInteractionEvent(const Particle&, const size_t&) const;
+
     void addInteractionEventInit(const Particle&, const size_t&) const;
 
     void addLocalEvent(const Particle&, const size_t&) const;
@@ -122,12 +235,53 @@ namespace dynamo {
      */
     void lazyDeletionCleanup();
 
+    //! fullUpdate, with its time added to the EventProfile.
+    void profiledFullUpdate(const Particle&);
+
+    /*! \brief Adds the global, local and interaction events of an up
+     * to date particle.
+     *
+     * \param neighboursUpToDate If false, the neighbours of the
+     * particle are brought up to date before their events are
+     * calculated.
+     */
+    void predictEvents(const Particle&, bool neighboursUpToDate) const;
+
+    /*! \brief Adds the interaction events between an up to date
+     * particle and the (up to date) particles with the passed IDs.
+     *
+     * The pairs are passed to Interaction::getEvents together, so
+     * the Interaction can test them as a batch.
+     */
+    void addInteractionEvents(const Particle&, const size_t* IDs, size_t N) const;
+
+    //! Adds the events of the (up to date) particles with IDs in the
+    //! range [start, end), this is the task run by each thread
+    //! during a rebuild.
+    void addEventsBlock(size_t start, size_t end) const;
+
+    magnet::thread::ThreadPool _threads;
+
     mutable std::tr1::shared_ptr<CSSorter> sorter;
     mutable std::vector<unsigned long> eventCount;
   
     size_t _interactionRejectionCounter;
     size_t _localRejectionCounter;
 
+    LazyDeletionStats _lazyStats;
+    double _pruneThreshold;
+    bool _skipTiming;
+
+    EventProfile _profile;
+    bool _profiling;
+
+    inline bool staleNextEvent() const
+    {
+      return (sorter->next_type() == INTERACTION)
+	&& (uint32_t(sorter->next_collCounter2())
+	    != uint32_t(eventCount[sorter->next_p2()]));
+    }
+
     virtual void outputXML(magnet::xml::XmlStream&) const = 0;
   };
 }
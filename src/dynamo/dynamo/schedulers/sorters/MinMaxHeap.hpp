@@ -26,10 +26,13 @@ namespace dynamo {
   //! MinMaxHeaps.  The top element is set to HUGE_VAL, whenever the
   //! queue is cleared, or pop'd empty. This means no conditional logic
   //! is required to deal with the comparison of empty queues.
-  template<size_t Size>
+  //!
+  //! The Event type sets the record stored for each event, either
+  //! \ref intPart or the smaller \ref compactIntPart.
+  template<size_t Size, class Event = intPart>
   class MinMaxHeapPList
   {
-    magnet::containers::MinMaxHeap<intPart,Size> _innerHeap;
+    magnet::containers::MinMaxHeap<Event,Size> _innerHeap;
 
   public:
     MinMaxHeapPList() 
@@ -43,8 +46,8 @@ namespace dynamo {
     inline bool empty() const { return _innerHeap.empty(); }
     inline bool full() const { return _innerHeap.full(); }
 
-    inline const intPart& front() const { return *_innerHeap.begin(); }
-    inline const intPart& top() const { return front(); }  
+    inline const Event& front() const { return *_innerHeap.begin(); }
+    inline const Event& top() const { return front(); }  
 
     inline void pop() 
     { 
@@ -71,18 +74,19 @@ namespace dynamo {
   
     inline void stream(const double& ndt) throw()
     {
-      BOOST_FOREACH(intPart& dat, _innerHeap)
+      BOOST_FOREACH(Event& dat, _innerHeap)
 	dat.dt -= ndt;
     }
 
     inline void addTime(const double& ndt) throw()
     {
-      BOOST_FOREACH(intPart& dat, _innerHeap)
+      BOOST_FOREACH(Event& dat, _innerHeap)
 	dat.dt += ndt;
     }
 
-    inline void push(const intPart& __x)
+    inline void push(const intPart& event)
     {
+      const Event __x(event);
       if (!_innerHeap.full())
 	_innerHeap.insert(__x);
       else 
@@ -95,10 +99,34 @@ namespace dynamo {
 
     inline void rescaleTimes(const double& scale) throw()
     { 
-      BOOST_FOREACH(intPart& dat, _innerHeap)
+      BOOST_FOREACH(Event& dat, _innerHeap)
 	dat.dt *= scale;
     }
 
+    inline size_t countStale(const StaleEvent& stale) const
+    { return std::count_if(_innerHeap.begin(), _innerHeap.end(), stale); }
+
+    //! \brief Removes the stale events, returning the number removed.
+    inline size_t prune(const StaleEvent& stale)
+    {
+      Event events[Size];
+      size_t kept(0), removed(0);
+      BOOST_FOREACH(const Event& dat, _innerHeap)
+	if (stale(dat))
+	  ++removed;
+	else
+	  events[kept++] = dat;
+
+      if (removed)
+	{
+	  clear();
+	  for (size_t i(0); i < kept; ++i)
+	    _innerHeap.insert(events[i]);
+	}
+
+      return removed;
+    }
+
     inline void swap(MinMaxHeapPList& rhs)
     {
       _innerHeap.swap(rhs._innerHeap);
@@ -110,8 +138,9 @@ namespace dynamo {
 namespace std
 {
   /*! \brief Template specialisation of the std::swap function for pList*/
-  template<size_t Size>
-  void swap(dynamo::MinMaxHeapPList<Size>& lhs, dynamo::MinMaxHeapPList<Size>& rhs)
+  template<size_t Size, class Event>
+  void swap(dynamo::MinMaxHeapPList<Size, Event>& lhs, 
+	    dynamo::MinMaxHeapPList<Size, Event>& rhs)
   {
     lhs.swap(rhs);
   }
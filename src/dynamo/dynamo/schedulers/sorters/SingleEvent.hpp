@@ -75,6 +75,14 @@ namespace dynamo {
     inline void rescaleTimes(const double& scale) throw()
     { _event.dt *= scale; }
 
+    inline size_t countStale(const StaleEvent& stale) const
+    { return !empty() && stale(_event); }
+
+    //! \brief The single event is already bounded, and a stale event
+    //! must still become a VIRTUAL event (see pop()), so nothing is
+    //! removed.
+    inline size_t prune(const StaleEvent&) { return 0; }
+
     inline void swap(PELSingleEvent& rhs)
     { std::swap(_event, rhs._event); }  
   };
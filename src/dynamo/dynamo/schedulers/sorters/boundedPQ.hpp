@@ -32,7 +32,7 @@
 #endif
 
 namespace dynamo {
-  template<size_t Size>
+  template<size_t Size, class Event>
   class MinMaxHeapPList;
 
   class pList;
@@ -52,11 +52,17 @@ namespace dynamo {
   };
 
   template<size_t I>
-  struct CSSBoundedPQName<MinMaxHeapPList<I> >
+  struct CSSBoundedPQName<MinMaxHeapPList<I, intPart> >
   {
     inline static std::string name() { return std::string("BoundedPQMinMax") + boost::lexical_cast<std::string>(I); }
   };
 
+  template<size_t I>
+  struct CSSBoundedPQName<MinMaxHeapPList<I, compactIntPart> >
+  {
+    inline static std::string name() { return std::string("BoundedPQCompactMinMax") + boost::lexical_cast<std::string>(I); }
+  };
+
   template<>
   struct CSSBoundedPQName<PELSingleEvent>
   {
@@ -306,6 +312,26 @@ namespace dynamo {
     inline void popNextEvent() { Min[CBT[1]].data.pop(); }
     inline bool nextPELEmpty() const { return Min[CBT[1]].data.empty(); }
 
+    size_t prune(const std::vector<unsigned long>& eventCount)
+    {
+      const StaleEvent stale(eventCount);
+      size_t removed(0);
+      for (size_t i(1); i < Min.size(); ++i)
+	if (const size_t n = Min[i].data.prune(stale))
+	  {
+	    removed += n;
+	    update(i - 1);
+	  }
+
+      sort();
+      return removed;
+    }
+
+    inline size_t PELSize(const size_t& ID) const { return Min[ID+1].data.size(); }
+
+    inline size_t PELStale(const size_t& ID, const std::vector<unsigned long>& eventCount) const
+    { return Min[ID+1].data.countStale(StaleEvent(eventCount)); }
+
     inline intPart copyNextEvent() const 
     { intPart retval(Min[CBT[1]].data.top());
       retval.dt -= pecTime;
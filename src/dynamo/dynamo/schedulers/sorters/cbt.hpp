@@ -105,6 +105,26 @@ namespace dynamo {
     inline void popNextEvent() { Min[CBT[1]].pop(); }
     inline bool nextPELEmpty() const { return Min[CBT[1]].empty(); }
 
+    size_t prune(const std::vector<unsigned long>& eventCount)
+    {
+      const StaleEvent stale(eventCount);
+      size_t removed(0);
+      for (size_t i(1); i < Min.size(); ++i)
+	if (const size_t n = Min[i].prune(stale))
+	  {
+	    removed += n;
+	    update(i - 1);
+	  }
+
+      sort();
+      return removed;
+    }
+
+    inline size_t PELSize(const size_t& ID) const { return Min[ID+1].size(); }
+
+    inline size_t PELStale(const size_t& ID, const std::vector<unsigned long>& eventCount) const
+    { return Min[ID+1].countStale(StaleEvent(eventCount)); }
+
     inline intPart copyNextEvent() const 
     { intPart retval(Min[CBT[1]].top());
       retval.dt -= pecTime;
@@ -22,8 +22,10 @@
 #include <dynamo/dynamics/locals/localEvent.hpp>
 #include <dynamo/dynamics/globals/global.hpp>
 #include <boost/foreach.hpp>
+#include <boost/static_assert.hpp>
 #include <algorithm>
 #include <queue>
+#include <stdint.h>
 
 namespace dynamo {
   //Datatype for a single event, stored in lists for each particle
@@ -91,6 +93,76 @@ namespace dynamo {
     size_t p2;  
   };
 
+  /*! \brief A packed version of \ref intPart, for the particle event
+    lists which hold many events per particle.
+
+    The partner ID and event counter are stored in 32 bits and the
+    event type in a byte, which brings the record down from 32 to 24
+    bytes. The time is kept as a double so the event ordering is
+    unchanged. As the counter wraps at 2^32, the scheduler only
+    compares the low 32 bits of the event counts.
+   */
+  class compactIntPart
+  {
+  public:
+    inline compactIntPart():
+      dt(HUGE_VAL),
+      collCounter2(std::numeric_limits<uint32_t>::max()),
+      p2(std::numeric_limits<uint32_t>::max()),
+      type(NONE)
+    {}
+
+    inline compactIntPart(const intPart& event) throw():
+      dt(event.dt),
+      collCounter2(event.collCounter2),
+      p2(event.p2),
+      type(event.type)
+    {}
+
+    inline operator intPart() const throw()
+    { return intPart(dt, type, p2, collCounter2); }
+
+    inline bool operator< (const compactIntPart& ip) const throw()
+    { return dt < ip.dt; }
+
+    inline bool operator> (const compactIntPart& ip) const throw()
+    { return dt > ip.dt; }
+
+    inline void stream(const double& ndt) throw() { dt -= ndt; }
+
+    mutable double dt;
+    uint32_t collCounter2;
+    uint32_t p2;
+    EEventType type : 8;
+  };
+
+  BOOST_STATIC_ASSERT(sizeof(compactIntPart) <= 24);
+
+  /*! \brief Tests if an interaction event has been invalidated by a
+    later event of its partner particle.
+
+    This is the test used by the lazy deletion scheme of the
+    Scheduler. Only the low 32 bits of the event counts are compared,
+    as that is all a \ref compactIntPart stores.
+   */
+  class StaleEvent
+  {
+  public:
+    StaleEvent(const std::vector<unsigned long>& eventCount):
+      _eventCount(eventCount)
+    {}
+
+    template<class Event>
+    inline bool operator()(const Event& event) const
+    { 
+      return (event.type == INTERACTION) 
+	&& (uint32_t(event.collCounter2) != uint32_t(_eventCount[event.p2]));
+    }
+
+  private:
+    const std::vector<unsigned long>& _eventCount;
+  };
+
   typedef std::vector<intPart> qType;
   typedef std::priority_queue<intPart, qType, 
 			      std::greater<intPart> > pList_q_type;
@@ -159,6 +231,22 @@ namespace dynamo {
 	dat.dt *= scale;
     }
 
+    inline size_t countStale(const StaleEvent& stale) const
+    { return std::count_if(c.begin(), c.end(), stale); }
+
+    //! \brief Removes the stale events, returning the number removed.
+    inline size_t prune(const StaleEvent& stale)
+    {
+      iterator newEnd = std::remove_if(c.begin(), c.end(), stale);
+      const size_t removed = c.end() - newEnd;
+      if (removed)
+	{
+	  c.erase(newEnd, c.end());
+	  std::make_heap(c.begin(), c.end(), comp);
+	}
+      return removed;
+    }
+
     inline void swap(pList& rhs)
     {
       c.swap(rhs.c);
@@ -0,0 +1,736 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/schedulers/sorters/datastruct.hpp>
+#include <dynamo/schedulers/sorters/sorter.hpp>
+#include <dynamo/base/is_simdata.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/lexical_cast.hpp>
+#include <magnet/exception.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <string>
+#include <vector>
+#include <cmath>
+
+#ifdef DYNAMO_DEBUG
+#include <boost/math/special_functions/fpclassify.hpp>
+#endif
+
+namespace dynamo {
+  template<size_t Size, class Event>
+  class MinMaxHeapPList;
+
+  class pList;
+
+  class PELSingleEvent;
+
+  template<class T>
+  struct CSSLadderQueueName
+  {
+    BOOST_STATIC_ASSERT(sizeof(T) == 0);
+  };
+
+  template<>
+  struct CSSLadderQueueName<pList>
+  {
+    inline static std::string name() { return "LadderQueue"; }
+  };
+
+  template<size_t I>
+  struct CSSLadderQueueName<MinMaxHeapPList<I, intPart> >
+  {
+    inline static std::string name() { return std::string("LadderQueueMinMax") + boost::lexical_cast<std::string>(I); }
+  };
+
+  template<size_t I>
+  struct CSSLadderQueueName<MinMaxHeapPList<I, compactIntPart> >
+  {
+    inline static std::string name() { return std::string("LadderQueueCompactMinMax") + boost::lexical_cast<std::string>(I); }
+  };
+
+  template<>
+  struct CSSLadderQueueName<PELSingleEvent>
+  {
+    inline static std::string name() { return "LadderQueueSingleEvent"; }
+  };
+
+  /*! \brief The counters collected by the \ref CSSLadderQueue sorter.
+
+    The per-rung vectors are indexed by the depth of the rung, with
+    rung 0 being the coarsest rung built directly from the Top list.
+   */
+  struct LadderQueueStats
+  {
+    LadderQueueStats(size_t maxRungs):
+      epochs(0),
+      rebases(0),
+      bottomInserts(0),
+      bottomOverflows(0),
+      maxBottomSize(0),
+      maxRungDepth(0),
+      rungSpawns(maxRungs, 0),
+      bucketTransfers(maxRungs, 0),
+      eventTransfers(maxRungs, 0)
+    {}
+
+    //! Number of times the Top list was spread into a new rung 0.
+    size_t epochs;
+    //! Number of times the peculiar time was folded into the events.
+    size_t rebases;
+    //! Events inserted straight into the Bottom tree.
+    size_t bottomInserts;
+    //! Buckets larger than the threshold which could not be split
+    //! further and were sorted directly in the Bottom tree.
+    size_t bottomOverflows;
+    //! The largest size of the Bottom tree.
+    size_t maxBottomSize;
+    //! The deepest rung spawned.
+    size_t maxRungDepth;
+    //! Number of rungs spawned at each depth.
+    std::vector<size_t> rungSpawns;
+    //! Number of buckets transferred into the Bottom from each depth.
+    std::vector<size_t> bucketTransfers;
+    //! Number of events transferred into the Bottom from each depth.
+    std::vector<size_t> eventTransfers;
+  };
+
+  /*! \brief A non-templated base class for the \ref CSSLadderQueue,
+    allowing output plugins to access its statistics regardless of
+    the event list type.
+   */
+  class CSSLadderQueueBase: public CSSorter
+  {
+  public:
+    CSSLadderQueueBase(const dynamo::SimData* const& SD, const char *aName, size_t maxRungs):
+      CSSorter(SD, aName),
+      _stats(maxRungs)
+    {}
+
+    inline const LadderQueueStats& getStats() const { return _stats; }
+
+    //! The number of particle event lists currently in the Bottom tree.
+    virtual size_t bottomSize() const = 0;
+    //! The number of particle event lists currently in the Top list.
+    virtual size_t topSize() const = 0;
+    //! The number of rungs currently active in the ladder.
+    virtual size_t activeRungs() const = 0;
+    //! The number of particle event lists in the given rung.
+    virtual size_t rungSize(size_t) const = 0;
+    //! The number of buckets in the given rung.
+    virtual size_t rungBuckets(size_t) const = 0;
+
+  protected:
+    LadderQueueStats _stats;
+  };
+
+  /*! \brief A self tuning Ladder Queue sorter.
+
+    This is an implementation of the Ladder Queue of Tang, Goh and
+    Thng, "Ladder Queue: An O(1) Priority Queue Structure for
+    Large-Scale Discrete Event Simulation", ACM TOMACS 15, 175
+    (2005). Like the \ref CSSBoundedPQ, the queue sorts the particle
+    event lists (PEL's) by their next event. Unlike the bounded
+    queue, there is no scale factor or list length to tune.
+
+    Future events are kept in an unsorted Top list. When the ladder
+    is exhausted, the Top list is spread over a new rung of buckets,
+    with the bucket width chosen from the number and time span of the
+    events. Buckets are consumed in order. Any bucket holding more
+    than \ref _threshold PEL's is split into a finer rung, otherwise
+    it is transferred into the Bottom, which is a complete binary
+    tree (the same as the \ref CSSCBT sorter). Each PEL is held in
+    exactly one location, and all lists are doubly linked, so updates
+    are O(1) in the Top list and rungs.
+   */
+  template<typename T = pList>
+  class CSSLadderQueue: public CSSLadderQueueBase
+  {
+  private:
+    //! Location markers for the eventQEntry::rung field. Positive
+    //! values are the depth of the rung the entry is held in.
+    enum
+      {
+	BOTTOM = -1,
+	TOP = -2,
+	NO_EVENTS = -3,
+	UNQUEUED = -4
+      };
+
+    struct eventQEntry
+    {
+      eventQEntry(): next(-1), previous(-1), rung(UNQUEUED), bucket(0) {}
+
+      T data;
+      int next;
+      int previous;
+      int rung;
+      size_t bucket;
+    };
+
+    struct Rung
+    {
+      //! The start time of the first bucket.
+      double start;
+      //! The width of the buckets.
+      double width;
+      //! The first bucket which has not yet been consumed.
+      size_t current;
+      //! The number of PEL's held in this rung.
+      size_t events;
+      std::vector<int> heads;
+      std::vector<size_t> counts;
+
+      inline double currentStart() const { return start + current * width; }
+    };
+
+    //! The largest bucket which is transferred directly into the
+    //! Bottom tree. This is larger than the value of 50 used in the
+    //! paper, as the Bottom is a tree and not a sorted linked list.
+    static const size_t _threshold = 200;
+    //! The maximum number of rungs in the ladder.
+    static const size_t _maxRungs = 8;
+
+    std::vector<eventQEntry> Min;
+
+    //Ladder variables
+    std::vector<Rung> rungs;
+    size_t nRungs;
+
+    //Top list variables
+    int topHead;
+    size_t topCount;
+    double topStart, topMin, topMax;
+
+    //PEL's with no events
+    int infHead;
+    size_t infCount;
+
+    double pecTime;
+    unsigned long streamFreq, nUpdate;
+
+    //Binary tree (Bottom) variables
+    std::vector<unsigned long> CBT;
+    std::vector<unsigned long> Leaf;
+    size_t NP, N;
+
+  public:
+    CSSLadderQueue(const dynamo::SimData* const& SD):
+      CSSLadderQueueBase(SD, "LadderQueue", _maxRungs)
+    { clear(); }
+
+    ~CSSLadderQueue()
+    {
+      dout << "Epochs = " << _stats.epochs
+	   << ", Max rung depth = " << _stats.maxRungDepth
+	   << ", Max bottom size = " << _stats.maxBottomSize
+	   << ", Bottom overflows = " << _stats.bottomOverflows
+	   << std::endl;
+
+      for (size_t i(0); i < _stats.maxRungDepth; ++i)
+	dout << "Rung " << i
+	     << ": Spawned = " << _stats.rungSpawns[i]
+	     << ", Buckets transferred = " << _stats.bucketTransfers[i]
+	     << ", Mean events per bucket = "
+	     << (_stats.bucketTransfers[i]
+		 ? double(_stats.eventTransfers[i]) / _stats.bucketTransfers[i]
+		 : 0.0)
+	     << std::endl;
+    }
+
+    inline size_t size() const { return Min.size() - 1; }
+    inline bool empty() const { return Min.empty(); }
+
+    inline size_t bottomSize() const { return NP; }
+    inline size_t topSize() const { return topCount; }
+    inline size_t activeRungs() const { return nRungs; }
+    inline size_t rungSize(size_t i) const { return rungs[i].events; }
+    inline size_t rungBuckets(size_t i) const { return rungs[i].heads.size(); }
+
+    void resize(const size_t& a)
+    {
+      clear();
+      N = a;
+      streamFreq = a;
+      CBT.resize(2 * N);
+      Leaf.resize(N + 1);
+      Min.resize(N + 1);
+    }
+
+    void clear()
+    {
+      CBT.clear();
+      Leaf.clear();
+      Min.clear();
+      rungs.clear();
+      rungs.resize(_maxRungs);
+      nRungs = 0;
+      clearTop();
+      topStart = -HUGE_VAL;
+      infHead = -1;
+      infCount = 0;
+      N = 0;
+      NP = 0;
+      pecTime = 0.0;
+      streamFreq = 0;
+      nUpdate = 0;
+    }
+
+    inline void stream(const double& ndt)
+    {
+      pecTime += ndt;
+
+      if (!(++nUpdate % streamFreq))
+	rebase();
+    }
+
+    void init() { init(false); }
+
+    void rebuild() { init(true); }
+
+    void init(bool quiet)
+    {
+      NP = 0;
+      nRungs = 0;
+      clearTop();
+      topStart = -HUGE_VAL;
+      infHead = -1;
+      infCount = 0;
+
+      for (unsigned long i = 1; i <= N; i++)
+	{
+	  Min[i].rung = UNQUEUED;
+	  insertInEventQ(i);
+	}
+
+      orderNextEvent();
+
+      if (!quiet)
+	dout << "Ladder built, " << nRungs << " rungs, " 
+	     << NP << " PEL's in the bottom" << std::endl;
+    }
+
+    inline void push(const intPart& tmpVal, const size_t& pID)
+    {
+#ifdef DYNAMO_DEBUG
+      if (boost::math::isnan(tmpVal.dt))
+	M_throw() << "NaN value pushed into the sorter! Should be Inf I guess?";
+#endif
+
+      tmpVal.dt += pecTime;
+      Min[pID + 1].data.push(tmpVal);
+    }
+
+    inline void update(const size_t& pID)
+    {
+      deleteFromEventQ(pID + 1);
+      insertInEventQ(pID + 1);
+    }
+
+    inline void clearPEL(const size_t& ID) { Min[ID+1].data.clear(); }
+    inline void popNextPELEvent(const size_t& ID) { Min[ID+1].data.pop(); }
+    inline void popNextEvent() { Min[CBT[1]].data.pop(); }
+    inline bool nextPELEmpty() const { return Min[CBT[1]].data.empty(); }
+
+    size_t prune(const std::vector<unsigned long>& eventCount)
+    {
+      const StaleEvent stale(eventCount);
+      size_t removed(0);
+      for (size_t i(1); i < Min.size(); ++i)
+	if (const size_t n = Min[i].data.prune(stale))
+	  {
+	    removed += n;
+	    update(i - 1);
+	  }
+
+      sort();
+      return removed;
+    }
+
+    inline size_t PELSize(const size_t& ID) const { return Min[ID+1].data.size(); }
+
+    inline size_t PELStale(const size_t& ID, const std::vector<unsigned long>& eventCount) const
+    { return Min[ID+1].data.countStale(StaleEvent(eventCount)); }
+
+    inline intPart copyNextEvent() const
+    { intPart retval(Min[CBT[1]].data.top());
+      retval.dt -= pecTime;
+      return retval;
+    }
+
+    inline size_t next_ID() const { return CBT[1] - 1; }
+    inline EEventType next_type() const { return Min[CBT[1]].data.top().type; }
+    inline unsigned long next_collCounter2() const { return Min[CBT[1]].data.top().collCounter2; }
+    inline size_t next_p2() const { return Min[CBT[1]].data.top().p2; }
+    inline double next_dt() const { return Min[CBT[1]].data.getdt() - pecTime; }
+
+    inline void sort() { orderNextEvent(); }
+
+    inline void rescaleTimes(const double& factor)
+    {
+      BOOST_FOREACH(eventQEntry& dat, Min)
+	dat.data.rescaleTimes(factor);
+
+      pecTime *= factor;
+      topStart *= factor;
+      topMin *= factor;
+      topMax *= factor;
+
+      for (size_t i(0); i < nRungs; ++i)
+	{
+	  rungs[i].start *= factor;
+	  rungs[i].width *= factor;
+	}
+    }
+
+  private:
+    ///////////////////////////LADDER IMPLEMENTATION
+    inline void clearTop()
+    {
+      topHead = -1;
+      topCount = 0;
+      topMin = HUGE_VAL;
+      topMax = -HUGE_VAL;
+    }
+
+    //! Fold the peculiar time into the stored event times, so that
+    //! the event times do not lose precision as the simulation runs.
+    inline void rebase()
+    {
+      ++_stats.rebases;
+
+      BOOST_FOREACH(eventQEntry& dat, Min)
+	dat.data.stream(pecTime);
+
+      topStart -= pecTime;
+      topMin -= pecTime;
+      topMax -= pecTime;
+
+      for (size_t i(0); i < nRungs; ++i)
+	rungs[i].start -= pecTime;
+
+      pecTime = 0;
+    }
+
+    inline void link(const int p, int& head)
+    {
+      Min[p].previous = -1;
+      Min[p].next = head;
+      if (head != -1) Min[head].previous = p;
+      head = p;
+    }
+
+    inline void unlink(const int p, int& head)
+    {
+      const int prev = Min[p].previous, next = Min[p].next;
+
+      if (prev == -1)
+	head = next;
+      else
+	Min[prev].next = next;
+
+      if (next != -1)
+	Min[next].previous = prev;
+    }
+
+    //! Place an entry in a bucket of a rung, the bucket index is
+    //! clamped to the unconsumed buckets to guard against rounding.
+    inline void insertInRung(const int p, const size_t r, const double t)
+    {
+      Rung& rung = rungs[r];
+      const double box = (t - rung.start) / rung.width;
+
+      size_t b = (box < rung.heads.size()) ? static_cast<size_t>(box) : rung.heads.size() - 1;
+      if (b < rung.current) b = rung.current;
+
+      Min[p].rung = r;
+      Min[p].bucket = b;
+      link(p, rung.heads[b]);
+      ++rung.counts[b];
+      ++rung.events;
+    }
+
+    inline void insertInEventQ(const int p)
+    {
+      const double t = Min[p].data.getdt();
+
+      if (t == HUGE_VAL)
+	{
+	  Min[p].rung = NO_EVENTS;
+	  link(p, infHead);
+	  ++infCount;
+	  return;
+	}
+
+      if (t > topStart)
+	{
+	  Min[p].rung = TOP;
+	  link(p, topHead);
+	  ++topCount;
+	  if (t < topMin) topMin = t;
+	  if (t > topMax) topMax = t;
+	  return;
+	}
+
+      for (size_t r(0); r < nRungs; ++r)
+	if (t >= rungs[r].currentStart())
+	  {
+	    insertInRung(p, r, t);
+	    return;
+	  }
+
+      ++_stats.bottomInserts;
+      insertInBottom(p);
+    }
+
+    inline void deleteFromEventQ(const int p)
+    {
+      switch (Min[p].rung)
+	{
+	case UNQUEUED:
+	  break;
+	case BOTTOM:
+	  Delete(p);
+	  break;
+	case TOP:
+	  unlink(p, topHead);
+	  --topCount;
+	  break;
+	case NO_EVENTS:
+	  unlink(p, infHead);
+	  --infCount;
+	  break;
+	default:
+	  {
+	    Rung& rung = rungs[Min[p].rung];
+	    unlink(p, rung.heads[Min[p].bucket]);
+	    --rung.counts[Min[p].bucket];
+	    --rung.events;
+	  }
+	}
+
+      Min[p].rung = UNQUEUED;
+    }
+
+    inline void insertInBottom(const int p)
+    {
+      Min[p].rung = BOTTOM;
+      Insert(p);
+      if (NP > _stats.maxBottomSize) _stats.maxBottomSize = NP;
+    }
+
+    //! Move every entry of a linked list into the Bottom tree.
+    inline void transferToBottom(int& head)
+    {
+      for (int e = head; e != -1;)
+	{
+	  const int eNext = Min[e].next;
+	  insertInBottom(e);
+	  e = eNext;
+	}
+      head = -1;
+    }
+
+    //! Spread the Top list over a new rung 0.
+    inline void transferTop()
+    {
+      ++_stats.epochs;
+
+      const double start = topMin;
+      const double width = (topMax - topMin) / topCount;
+      const size_t nbuckets = topCount + 1;
+      int head = topHead;
+      topStart = topMax;
+      clearTop();
+
+      //All the events are (numerically) simultaneous, no point in
+      //building a rung
+      if (!(width > 0) || (start + width == start))
+	{
+	  transferToBottom(head);
+	  return;
+	}
+
+      newRung(start, width, nbuckets);
+
+      for (int e = head; e != -1;)
+	{
+	  const int eNext = Min[e].next;
+	  insertInRung(e, 0, Min[e].data.getdt());
+	  e = eNext;
+	}
+    }
+
+    inline void newRung(const double start, const double width, const size_t nbuckets)
+    {
+      Rung& rung = rungs[nRungs];
+      rung.start = start;
+      rung.width = width;
+      rung.current = 0;
+      rung.events = 0;
+      rung.heads.assign(nbuckets, -1);
+      rung.counts.assign(nbuckets, 0);
+
+      ++_stats.rungSpawns[nRungs];
+      if (++nRungs > _stats.maxRungDepth) _stats.maxRungDepth = nRungs;
+    }
+
+    inline void orderNextEvent()
+    {
+      while (NP == 0)
+	{
+	  if (!nRungs)
+	    {
+	      if (topCount)
+		transferTop();
+	      else if (infCount)
+		{
+		  //Only PEL's without events remain, place them in the
+		  //bottom so the scheduler can detect this
+		  transferToBottom(infHead);
+		  infCount = 0;
+		}
+	      else
+		M_throw() << "The ladder queue is empty!";
+
+	      continue;
+	    }
+
+	  const size_t r = nRungs - 1;
+	  Rung& rung = rungs[r];
+
+	  if (!rung.events)
+	    {
+	      //This rung has been consumed
+	      --nRungs;
+	      continue;
+	    }
+
+	  while (rung.heads[rung.current] == -1)
+	    ++rung.current;
+
+	  const size_t b = rung.current++;
+	  const size_t count = rung.counts[b];
+	  int head = rung.heads[b];
+	  rung.heads[b] = -1;
+	  rung.counts[b] = 0;
+	  rung.events -= count;
+
+	  if (count > _threshold)
+	    {
+	      const double start = rung.start + b * rung.width;
+	      const double width = rung.width / count;
+
+	      if ((nRungs < _maxRungs) && (width > 0) && (start + width != start))
+		{
+		  newRung(start, width, count);
+		  for (int e = head; e != -1;)
+		    {
+		      const int eNext = Min[e].next;
+		      insertInRung(e, r + 1, Min[e].data.getdt());
+		      e = eNext;
+		    }
+		  continue;
+		}
+
+	      ++_stats.bottomOverflows;
+	    }
+
+	  ++_stats.bucketTransfers[r];
+	  _stats.eventTransfers[r] += count;
+	  transferToBottom(head);
+	}
+    }
+
+    ///////////////////////////BINARY TREE IMPLEMENTATION
+    inline void UpdateCBT(const unsigned int& i)
+    {
+      unsigned int f = Leaf[i] / 2;
+
+      for(; (f > 0) && (CBT[f] == i); f /= 2)
+	{
+	  unsigned int l = CBT[f*2],
+	    r = CBT[f*2+1];
+	  CBT[f] = (Min[r].data > Min[l].data) ? l : r;
+	}
+
+      //Walk up finding the winners till it doesn't change or you hit
+      //the top of the tree
+      for( ; f>0; f /= 2)
+	{
+	  unsigned int w = CBT[f], /* old winner */
+	    l = CBT[f*2],
+	    r = CBT[f*2+1];
+
+	  CBT[f] = (Min[r].data > Min[l].data) ? l : r;
+
+	  if (CBT[f] == w) return; /* end of the event time comparisons */
+	}
+    }
+
+    inline void Insert(const unsigned int& i)
+    {
+      if (NP)
+	{
+	  int j = CBT[NP];
+	  CBT [NP*2] = j;
+	  CBT [NP*2+1] = i;
+	  Leaf[j] = NP*2;
+	  Leaf[i]= NP*2+1;
+	  ++NP;
+	  UpdateCBT(j);
+	}
+      else
+	{
+	  CBT[1]=i;
+	  ++NP;
+	}
+    }
+
+    inline void Delete(const unsigned int& i)
+    {
+      if (NP < 2) { CBT[1]=0; Leaf[0]=1; --NP; return; }
+
+      int l = NP * 2 - 1;
+
+      if (CBT[l-1] == i)
+	{
+	  Leaf[CBT[l]] = l/2;
+	  CBT[l/2] =CBT[l];
+	  UpdateCBT(CBT[l]);
+	  --NP;
+	  return;
+	}
+
+      Leaf[CBT[l-1]] = l/2;
+      CBT[l/2] = CBT[l-1];
+      UpdateCBT(CBT[l-1]);
+
+      if (CBT[l] != i)
+	{
+	  CBT[Leaf[i]] = CBT[l];
+	  Leaf[CBT[l]] = Leaf[i];
+	  UpdateCBT(CBT[l]);
+	}
+
+      --NP;
+    }
+
+    virtual void outputXML(magnet::xml::XmlStream& XML) const
+    { XML << magnet::xml::attr("Type") << CSSLadderQueueName<T>::name(); }
+  };
+}
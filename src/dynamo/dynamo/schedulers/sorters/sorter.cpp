@@ -46,6 +46,52 @@ namespace dynamo {
       return new CSSBoundedPQ<MinMaxHeapPList<7> >(Sim);
     if (std::string(XML.getAttribute("Type")) == CSSBoundedPQName<MinMaxHeapPList<8> >::name())
       return new CSSBoundedPQ<MinMaxHeapPList<8> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSBoundedPQName<MinMaxHeapPList<2, compactIntPart> >::name())
+      return new CSSBoundedPQ<MinMaxHeapPList<2, compactIntPart> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSBoundedPQName<MinMaxHeapPList<3, compactIntPart> >::name())
+      return new CSSBoundedPQ<MinMaxHeapPList<3, compactIntPart> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSBoundedPQName<MinMaxHeapPList<4, compactIntPart> >::name())
+      return new CSSBoundedPQ<MinMaxHeapPList<4, compactIntPart> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSBoundedPQName<MinMaxHeapPList<5, compactIntPart> >::name())
+      return new CSSBoundedPQ<MinMaxHeapPList<5, compactIntPart> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSBoundedPQName<MinMaxHeapPList<6, compactIntPart> >::name())
+      return new CSSBoundedPQ<MinMaxHeapPList<6, compactIntPart> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSBoundedPQName<MinMaxHeapPList<7, compactIntPart> >::name())
+      return new CSSBoundedPQ<MinMaxHeapPList<7, compactIntPart> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSBoundedPQName<MinMaxHeapPList<8, compactIntPart> >::name())
+      return new CSSBoundedPQ<MinMaxHeapPList<8, compactIntPart> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<pList>::name())
+      return new CSSLadderQueue<>(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<PELSingleEvent>::name())
+      return new CSSLadderQueue<PELSingleEvent>(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<2> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<2> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<3> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<3> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<4> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<4> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<5> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<5> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<6> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<6> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<7> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<7> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<8> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<8> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<2, compactIntPart> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<2, compactIntPart> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<3, compactIntPart> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<3, compactIntPart> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<4, compactIntPart> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<4, compactIntPart> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<5, compactIntPart> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<5, compactIntPart> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<6, compactIntPart> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<6, compactIntPart> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<7, compactIntPart> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<7, compactIntPart> >(Sim);
+    if (std::string(XML.getAttribute("Type")) == CSSLadderQueueName<MinMaxHeapPList<8, compactIntPart> >::name())
+      return new CSSLadderQueue<MinMaxHeapPList<8, compactIntPart> >(Sim);
     else if (std::string(XML.getAttribute("Type")) == std::string("CBT"))
       return new CSSCBT(Sim);
     else 
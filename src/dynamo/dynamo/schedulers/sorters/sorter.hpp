@@ -57,6 +57,15 @@ namespace dynamo {
     virtual void   popNextEvent()                            = 0;
     virtual bool nextPELEmpty() const                        = 0;
 
+    //! Removes the stale interaction events from every PEL and
+    //! returns the number removed.
+    virtual size_t prune(const std::vector<unsigned long>&)   = 0;
+    //! The number of events in the PEL of a particle.
+    virtual size_t PELSize(const size_t&)              const = 0;
+    //! The number of stale interaction events in the PEL of a particle.
+    virtual size_t PELStale(const size_t&, 
+			    const std::vector<unsigned long>&) const = 0;
+
     //! Fetch the next event in the list, 
     virtual intPart   copyNextEvent() const               = 0;
 
@@ -18,16 +18,92 @@
 #pragma once
 
 #include <magnet/math/vector.hpp>
+#include <magnet/exception.hpp>
+#include <vector>
+#include <new>
+#include <stdint.h>
+#include <limits>
 
 namespace magnet { namespace xml { class Node; class XmlStream; } }
 
 namespace dynamo {
+  class ParticleStore;
+
+  //! \brief The peculiar time of a Particle's delayed state.
+  //!
+  //! The time is relative to the start of the streaming epoch in
+  //! which it was set (see Liouvillean::stream). Both are stored
+  //! together so that they share a cache line.
+  struct PecTime
+  {
+    PecTime(const double time = 0, const size_t epoch = 0):
+      _time(time), _epoch(epoch)
+    {}
+
+    double _time;
+    size_t _epoch;
+  };
+
+  namespace detail {
+    //! \brief The contiguous (structure of arrays) storage of the
+    //! fundamental particle data.
+    //!
+    //! Each field of the particles is held in its own array, so that
+    //! bulk passes over a single field (e.g., the peculiar times) only
+    //! touch the memory they need.
+    struct ParticleData
+    {
+      ParticleData(const bool detached = false):
+	_detached(detached)
+      {}
+
+      inline void push_back(const Vector& pos, const Vector& vel, 
+			    const PecTime& pecTime, const int state)
+      {
+	_pos.push_back(pos);
+	_vel.push_back(vel);
+	_pecTime.push_back(pecTime);
+	_state.push_back(state);
+      }
+
+      inline void reserve(const size_t n)
+      {
+	_pos.reserve(n);
+	_vel.reserve(n);
+	_pecTime.reserve(n);
+	_state.reserve(n);
+      }
+
+      inline void clear()
+      {
+	_pos.clear();
+	_vel.clear();
+	_pecTime.clear();
+	_state.clear();
+      }
+
+      std::vector<Vector> _pos;
+      std::vector<Vector> _vel;
+      std::vector<PecTime> _pecTime;
+      std::vector<int> _state;
+      //! Set if this is the private data of a single Particle.
+      bool _detached;
+    };
+  }
+
   //! \brief The fundamental data structure for a Particle.
   //!
   //! This class holds only the very fundamental information on a
   //! particle, such as its position, velocity, ID, and state
   //! flags. Other data is "attached" to this particle using
   //! Property classes stored in the PropertyStore.
+  //!
+  //! The data of the particles of a simulation is actually stored
+  //! in the arrays of a \ref ParticleStore, and the Particle's held
+  //! in the store are lightweight proxies to it (holding the ID and
+  //! the slot of the particle's data in the arrays). A Particle which
+  //! is constructed directly (or copied) owns its own data, so the
+  //! class still has value semantics.
   class Particle
   {
   public:
@@ -40,10 +116,10 @@ namespace dynamo {
 	XML << magnet::xml::attr("Static") <<  "Static";
 
       XML << magnet::xml::tag("P")
-	  << (particle._pos)
+	  << particle.getPosition()
 	  << magnet::xml::endtag("P")
 	  << magnet::xml::tag("V")
-	  << (particle._vel)
+	  << particle.getVelocity()
 	  << magnet::xml::endtag("V");
   
 
@@ -54,23 +130,46 @@ namespace dynamo {
     inline Particle (const Vector  &position, 
 		     const Vector  &velocity,
 		     const unsigned long& nID):
-      _pos(position), _vel(velocity), 
-      _ID(nID), _peculiarTime(0.0),
-      _state(DEFAULT)
-    {}
+      _data(new detail::ParticleData(true)), _ID(nID), _slot(0)
+    { _data->push_back(position, velocity, PecTime(), DEFAULT); }
   
     //! \brief Constructor to build a particle from an XML node.
     Particle(const magnet::xml::Node& XML, unsigned long nID):
-      _ID(nID),
-      _peculiarTime(0.0),
-      _state(DEFAULT)
+      _data(new detail::ParticleData(true)), _ID(nID), _slot(0)
     {
+      _data->push_back(Vector(0,0,0), Vector(0,0,0), PecTime(), DEFAULT);
+
       if (XML.hasAttribute("Static")) clearState(DYNAMIC);
     
-      _pos << XML.getNode("P");
-      _vel << XML.getNode("V");
+      getPosition() << XML.getNode("P");
+      getVelocity() << XML.getNode("V");
+    }
+
+    //! \brief Copy constructor, the copy always owns its data.
+    inline Particle(const Particle& p):
+      _data(new detail::ParticleData(true)), _ID(p._ID), _slot(0)
+    { _data->push_back(p.getPosition(), p.getVelocity(), 
+			 p._data->_pecTime[p.index()], p.getStateFlags()); }
+
+    //! \brief Assignment operator, this copies the values of the
+    //! particle and not the location of its data.
+    inline Particle& operator=(const Particle& p)
+    {
+      if (this != &p)
+	{
+	  getPosition() = p.getPosition();
+	  getVelocity() = p.getVelocity();
+	  _data->_pecTime[index()] = p._data->_pecTime[p.index()];
+	  getStateFlags() = p.getStateFlags();
+	  //The ID of a particle in a ParticleStore is its index
+	  if (_data->_detached)
+	    _ID = p._ID;
+	}
+      return *this;
     }
 
+    inline ~Particle() { if (_data->_detached) delete _data; }
+
     //! \brief Equal to comparison operator.
     //! This comparison operator only compares the ID's of the Particle
     //! classes. 
@@ -81,26 +180,31 @@ namespace dynamo {
     inline bool operator!=(const Particle &p) const { return (_ID != p._ID); }
   
     //! \brief Const position accessor function.
-    inline const Vector  &getPosition() const { return _pos; }
+    inline const Vector  &getPosition() const { return _data->_pos[index()]; }
     //! \brief Const velocity accessor function.
-    inline const Vector  &getVelocity() const { return _vel; }
+    inline const Vector  &getVelocity() const { return _data->_vel[index()]; }
   
     //! \brief Position accessor function.
-    inline Vector& getPosition() { return _pos; }
+    inline Vector& getPosition() { return _data->_pos[index()]; }
     //! \brief Velocity accessor function.
-    inline Vector& getVelocity() { return _vel; }
+    inline Vector& getVelocity() { return _data->_vel[index()]; }
   
     //! \brief ID accessor function.
     //! This ID is a unique value for each Particle in the Simulation
     //! and so it can also be used as a reference to a particle.
-    inline const unsigned long &getID() const { return _ID; };
+    inline unsigned long getID() const { return _ID; };
 
     //! \brief Const peculiar time accessor function.
     //! This value is used in the "delayed states" or "Time warp" algorithm.
-    inline const double& getPecTime() const { return _peculiarTime; }
+    inline const double& getPecTime() const { return _data->_pecTime[index()]._time; }
     //! \brief Peculiar time accessor function.
     //! This value is used in the "delayed states" or "Time warp" algorithm.
-    inline double& getPecTime() { return _peculiarTime; }
+    inline double& getPecTime() { return _data->_pecTime[index()]._time; }
+
+    //! \brief Const accessor for the streaming epoch of the peculiar time.
+    inline const size_t& getPecEpoch() const { return _data->_pecTime[index()]._epoch; }
+    //! \brief Accessor for the streaming epoch of the peculiar time.
+    inline size_t& getPecEpoch() { return _data->_pecTime[index()]._epoch; }
   
     //! \brief The possible State flags of the Particle, these states may be combined.
     typedef enum {
@@ -111,21 +215,216 @@ namespace dynamo {
   
     //! \brief Used to test if the Particle has a State flag set.
     //! \param teststate The State flag to test.
-    inline bool testState(State teststate) const { return _state & teststate; }
+    inline bool testState(State teststate) const { return getStateFlags() & teststate; }
 
     //! \brief Sets a State flag of the Particle
     //! \param nState The State flag to set.
-    inline void setState(State nState) { _state |= nState; }
+    inline void setState(State nState) { getStateFlags() |= nState; }
 
     //! \brief Clears a State flag of the Particle
     //! \param nState The State flag to clear.
-    inline void clearState(State nState) { _state &= (~nState); }  
+    inline void clearState(State nState) { getStateFlags() &= (~nState); }  
 
   private:
-    Vector _pos;
-    Vector _vel;
-    unsigned long _ID;
-    double _peculiarTime;
-    int _state;
+    friend class ParticleStore;
+
+    //! \brief Constructor for the proxies held in a ParticleStore.
+    inline Particle(detail::ParticleData* data, unsigned long nID, size_t slot):
+      _data(data), _ID(nID), _slot(slot)
+    {}
+
+    inline size_t index() const { return _slot; }
+
+    inline const int& getStateFlags() const { return _data->_state[index()]; }
+    inline int& getStateFlags() { return _data->_state[index()]; }
+
+    //32 bit ID and slot keep the proxies at 16 bytes.
+    detail::ParticleData* _data;
+    uint32_t _ID;
+    uint32_t _slot;
+  };
+
+  //! \brief A container of Particle's, storing their data as a
+  //! structure of arrays.
+  //!
+  //! The interface mimics the parts of std::vector<Particle> used
+  //! throughout dynamo, and the elements are Particle proxies into
+  //! the contiguous position, velocity, peculiar time and state
+  //! arrays. These arrays are also directly accessible for bulk
+  //! operations over every particle. The addresses of the elements
+  //! are only invalidated by a reallocation of the store.
+  //!
+  //! The proxies are always indexed by the particle ID, but the data
+  //! in the arrays may be stored in a different order (see
+  //! reorder()), so that particles which are close in space are also
+  //! close in memory.
+  class ParticleStore
+  {
+  public:
+    typedef Particle value_type;
+    typedef Particle& reference;
+    typedef const Particle& const_reference;
+    typedef Particle* iterator;
+    typedef const Particle* const_iterator;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    ParticleStore(): _proxies(NULL), _size(0), _capacity(0) {}
+
+    ParticleStore(const ParticleStore& other):
+      _data(other._data), _proxies(NULL), _size(0), _capacity(0)
+    { 
+      reallocate(other._size);
+      for (; _size < other._size; ++_size)
+	new (_proxies + _size) Particle(&_data, _size, other._proxies[_size]._slot);
+    }
+
+    ParticleStore& operator=(const ParticleStore& other)
+    {
+      if (this != &other)
+	{
+	  clear();
+	  _data = other._data;
+	  reallocate(other._size);
+	  for (; _size < other._size; ++_size)
+	    new (_proxies + _size) Particle(&_data, _size, other._proxies[_size]._slot);
+	}
+      return *this;
+    }
+
+    ~ParticleStore()
+    {
+      clear();
+      ::operator delete(_proxies);
+    }
+
+    inline size_t size() const { return _size; }
+    inline bool empty() const { return !_size; }
+
+    inline iterator begin() { return _proxies; }
+    inline const_iterator begin() const { return _proxies; }
+    inline iterator end() { return _proxies + _size; }
+    inline const_iterator end() const { return _proxies + _size; }
+
+    inline Particle& operator[](const size_t i) { return _proxies[i]; }
+    inline const Particle& operator[](const size_t i) const { return _proxies[i]; }
+
+    inline Particle& front() { return _proxies[0]; }
+    inline const Particle& front() const { return _proxies[0]; }
+    inline Particle& back() { return _proxies[_size - 1]; }
+    inline const Particle& back() const { return _proxies[_size - 1]; }
+
+    //! \brief Append a copy of the passed Particle to the store.
+    //!
+    //! The ID of the particle must be its index in the store.
+    inline void push_back(const Particle& p)
+    {
+      if (p.getID() != _size)
+	M_throw() << "Particle ID " << p.getID() << " does not match its index " 
+		  << _size << " in the ParticleStore";
+
+      if (_size == std::numeric_limits<uint32_t>::max())
+	M_throw() << "Too many particles for the ParticleStore";
+
+      if (_size == _capacity)
+	reallocate(_capacity ? 2 * _capacity : 16);
+
+      _data.push_back(p.getPosition(), p.getVelocity(), p._data->_pecTime[p.index()], 
+		      p.getStateFlags());
+      new (_proxies + _size) Particle(&_data, _size, _data._pos.size() - 1);
+      ++_size;
+    }
+
+    inline void reserve(const size_t n)
+    {
+      _data.reserve(n);
+      reallocate(n);
+    }
+
+    inline void clear()
+    {
+      for (size_t i(0); i < _size; ++i)
+	_proxies[i].~Particle();
+      _size = 0;
+      _data.clear();
+    }
+
+    //! \brief The positions of all particles, in storage order.
+    //!
+    //! The storage order is not the ID order once the store has been
+    //! reordered, so these arrays must not be indexed by particle ID.
+    inline std::vector<Vector>& getPositions() { return _data._pos; }
+    inline const std::vector<Vector>& getPositions() const { return _data._pos; }
+
+    //! \brief The velocities of all particles, in storage order.
+    inline std::vector<Vector>& getVelocities() { return _data._vel; }
+    inline const std::vector<Vector>& getVelocities() const { return _data._vel; }
+
+    //! \brief The peculiar times of all particles, in storage order.
+    inline std::vector<PecTime>& getPecTimes() { return _data._pecTime; }
+    inline const std::vector<PecTime>& getPecTimes() const { return _data._pecTime; }
+
+    //! \brief Rearrange the particle data in memory.
+    //!
+    //! The IDs of the particles, and the addresses of the Particle
+    //! proxies, are unchanged. Only the slots of the data in the
+    //! arrays are moved.
+    //!
+    //! \param order The IDs of all the particles, in the order their
+    //! data is to be stored.
+    void reorder(const std::vector<size_t>& order)
+    {
+      if (order.size() != _size)
+	M_throw() << "The new order of the ParticleStore has " << order.size()
+		  << " entries, expected " << _size;
+
+      detail::ParticleData newData;
+      newData.reserve(_size);
+
+      std::vector<bool> placed(_size, false);
+      for (size_t slot(0); slot < _size; ++slot)
+	{
+	  const size_t ID = order[slot];
+	  if ((ID >= _size) || placed[ID])
+	    M_throw() << "The new order of the ParticleStore is not a permutation";
+	  placed[ID] = true;
+
+	  const size_t oldSlot = _proxies[ID]._slot;
+	  newData.push_back(_data._pos[oldSlot], _data._vel[oldSlot], 
+			    _data._pecTime[oldSlot], _data._state[oldSlot]);
+	}
+
+      _data._pos.swap(newData._pos);
+      _data._vel.swap(newData._vel);
+      _data._pecTime.swap(newData._pecTime);
+      _data._state.swap(newData._state);
+
+      for (size_t slot(0); slot < _size; ++slot)
+	_proxies[order[slot]]._slot = slot;
+    }
+
+  private:
+    //! \brief Grow the proxy array to hold at least n particles.
+    inline void reallocate(const size_t n)
+    {
+      if (n <= _capacity) return;
+
+      Particle* newProxies = static_cast<Particle*>(::operator new(n * sizeof(Particle)));
+
+      for (size_t i(0); i < _size; ++i)
+	{
+	  new (newProxies + i) Particle(&_data, i, _proxies[i]._slot);
+	  _proxies[i].~Particle();
+	}
+
+      ::operator delete(_proxies);
+      _proxies = newProxies;
+      _capacity = n;
+    }
+
+    detail::ParticleData _data;
+    Particle* _proxies;
+    size_t _size;
+    size_t _capacity;
   };
 }
@@ -22,10 +22,72 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <ostream>
 #include <cmath>
 #include <tr1/memory>
 
 namespace dynamo {
+  /*! \brief A fast, non-virtual accessor to the values of a Property.
+   *
+   * Looking up a value through the Property interface costs a
+   * virtual call for every particle. A PropertyHandle instead holds
+   * a pointer to the values of the Property and a stride: the stride
+   * is zero for a Property with a single value (e.g.,
+   * NumericProperty), so every ID maps to the same value, and one for
+   * a Property with a value per particle (e.g., ParticleProperty).
+   *
+   * Handles are fetched with Property::getHandle once the
+   * configuration is loaded, e.g., in Interaction::initialise. The
+   * handle remains valid while the Property exists and its values
+   * are not reloaded. Unit rescaling changes the values in place, so
+   * a handle will see the rescaled values.
+   */
+  class PropertyHandle
+  {
+  public:
+    inline PropertyHandle(): _data(NULL), _stride(0) {}
+
+    inline PropertyHandle(const double* data, size_t stride):
+      _data(data), _stride(stride) {}
+
+    //! Fetch the value of the property for a particle with a certain ID
+    inline const double& operator[](size_t ID) const
+    {
+#ifdef DYNAMO_DEBUG
+      if (!_data)
+	M_throw() << "PropertyHandle used before it was set";
+#endif
+      return _data[ID * _stride];
+    }
+
+    //! True if the property has the same value for every particle.
+    inline bool isConstant() const { return !_stride; }
+
+  private:
+    const double* _data;
+    size_t _stride;
+  };
+
+  /*! \brief A PropertyHandle to a single value, stored in the handle.
+   *
+   * This has the same interface as PropertyHandle, and is used to
+   * instantiate templated code for the case where a property has the
+   * same value for every particle, so the value is known to be
+   * constant at compile time.
+   */
+  class ConstantPropertyHandle
+  {
+  public:
+    inline explicit ConstantPropertyHandle(double val): _val(val) {}
+
+    inline const double& operator[](size_t) const { return _val; }
+
+    inline bool isConstant() const { return true; }
+
+  private:
+    double _val;
+  };
+
   //! \brief A interface class which allows other classes to access a property
   //! of a particle.  
   //!
@@ -50,6 +112,10 @@ namespace dynamo {
     inline virtual const double& getMaxValue() const
     { M_throw() << "Unimplemented"; }
 
+    //! Fetch a PropertyHandle to the values of this property
+    inline virtual PropertyHandle getHandle() const
+    { M_throw() << "Unimplemented"; }
+
     //! This is called whenever a unit is rescaled.
     //!
     //! This function must check the _units of the property and raise
@@ -78,6 +144,17 @@ namespace dynamo {
     inline virtual void outputParticleXMLData(magnet::xml::XmlStream& XML, 
 					      const size_t pID) const {}
 
+    //! Write the values of this Property on all N particles as raw
+    //! doubles, for the binary configuration format.
+    inline virtual void outputParticleBinaryData(std::ostream& os, 
+						 const size_t N) const {}
+
+    //! Load the values written by outputParticleBinaryData.
+    //! \return A pointer to the data following this Property's values.
+    inline virtual const double* loadParticleBinaryData(const double* data, 
+							const size_t N)
+    { return data; }
+
   protected:
     virtual void outputXML(magnet::xml::XmlStream& XML) const 
     { M_throw() << "Unimplemented"; }
@@ -107,6 +184,9 @@ namespace dynamo {
     //! returned as the max.
     inline virtual const double& getMaxValue() const { return _val; }
 
+    //! Every particle maps to the single value.
+    inline virtual PropertyHandle getHandle() const { return PropertyHandle(&_val, 0); }
+
     //! \sa Property::rescaleUnit
     inline virtual const void rescaleUnit(const Units::Dimension dim, 
 					  const double rescale)
@@ -172,6 +252,9 @@ namespace dynamo {
   
     inline virtual const double& getMaxValue() const 
     { return *std::max_element(_values.begin(), _values.end()); }
+
+    inline virtual PropertyHandle getHandle() const 
+    { return PropertyHandle(_values.empty() ? NULL : &_values[0], 1); }
   
     //! \sa Property::rescaleUnit
     inline virtual const void rescaleUnit(const Units::Dimension dim, 
@@ -185,6 +268,21 @@ namespace dynamo {
 
     inline void outputParticleXMLData(magnet::xml::XmlStream& XML, const size_t pID) const
     { XML << magnet::xml::attr(_name) << getProperty(pID); }
+
+    inline void outputParticleBinaryData(std::ostream& os, const size_t N) const
+    { 
+      if (_values.size() != N)
+	M_throw() << "ParticleProperty \"" << _name << "\" has " << _values.size()
+		  << " values, but there are " << N << " particles";
+
+      os.write(reinterpret_cast<const char*>(&_values[0]), N * sizeof(double));
+    }
+
+    inline const double* loadParticleBinaryData(const double* data, const size_t N)
+    { 
+      _values.assign(data, data + N);
+      return data + N;
+    }
   
   
   protected:
@@ -330,6 +428,29 @@ namespace dynamo {
 	(*iPtr)->outputParticleXMLData(XML, pID);
     }
 
+    //! \brief The number of Property-s which store per-particle
+    //! data in the binary configuration format.
+    inline size_t namedPropertyCount() const { return _namedProperties.size(); }
+
+    //! \brief Write the per-particle data of all Property-s as raw
+    //! doubles, in the order the Property-s are written to the XML.
+    inline void outputParticleBinaryData(std::ostream& os, size_t N) const 
+    {
+      for (const_iterator iPtr = _namedProperties.begin(); 
+	   iPtr != _namedProperties.end(); ++iPtr)
+	(*iPtr)->outputParticleBinaryData(os, N);
+    }
+
+    //! \brief Load the data written by outputParticleBinaryData.
+    //! \return A pointer to the data following the Property values.
+    inline const double* loadParticleBinaryData(const double* data, size_t N)
+    {
+      for (iterator iPtr = _namedProperties.begin(); 
+	   iPtr != _namedProperties.end(); ++iPtr)
+	data = (*iPtr)->loadParticleBinaryData(data, N);
+      return data;
+    }
+
     /*! \brief Method for pushing constructed properties into the
      * PropertyStore.
      *
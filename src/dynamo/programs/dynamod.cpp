@@ -78,6 +78,12 @@ main(int argc, char *argv[])
 	 "rounding errors (used in the test harness).")
 	("unwrapped", "Don't apply the boundary conditions of the system when writing out the particle positions.")
 	("check", "Runs tests on the configuration to ensure the system is not in an invalid state.")
+	("check-threads", po::value<size_t>(), 
+	 "Number of threads used to run the tests of --check.")
+	("io-threads", po::value<size_t>(), 
+	 "Number of threads used to compress and decompress the configuration "
+	 "files. With more than one thread, configurations are written as "
+	 "multi-stream bzip2 files so they can also be loaded in parallel.")
 	;
 
       loadopts.add_options()
@@ -129,6 +135,9 @@ main(int argc, char *argv[])
 
       if (vm.count("random-seed"))
 	sim.setRandSeed(vm["random-seed"].as<unsigned int>());
+
+      if (vm.count("io-threads"))
+	sim.ioThreads = vm["io-threads"].as<size_t>();
       
       ////////////////////////Simulation Initialisation!!!!!!!!!!!!!
       //Now load the config
@@ -178,7 +187,12 @@ main(int argc, char *argv[])
 	  .zeroMomentum();	
 
       if (vm.count("check"))
-	sim.checkSystem();
+	{
+	  if (vm.count("check-threads"))
+	    sim.ptrScheduler->setThreadCount(vm["check-threads"].as<size_t>());
+
+	  sim.checkSystem();
+	}
 
       if (vm.count("zero-com"))
 	dynamo::CInputPlugin(&sim, "CentreOfMassZeroer")
@@ -0,0 +1,238 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <map>
+#include <cstddef>
+
+namespace magnet {
+  namespace containers {
+    /*! \brief A sorted map from long keys to values, stored in a
+     * contiguous array while the keys are densely packed.
+     *
+     * This is a replacement for a std::map<long, T> where the keys
+     * are expected to lie close together, such as the bins of a
+     * histogram. The values are stored in an array with an offset,
+     * which grows in both directions as new keys are accessed. Only
+     * keys which have been accessed are visited during iteration, so
+     * the iteration is identical to a std::map.
+     *
+     * If the accessed keys ever span more than \ref maxDenseSpan
+     * values, the values are moved into a std::map and the container
+     * behaves like a std::map from then on.
+     *
+     * Only the parts of the std::map interface needed by the \ref
+     * FuzzyArray are provided. The iterators are read only and
+     * return the (key, value) pairs by value.
+     *
+     * \tparam T The type stored in the DenseMap.
+     */
+    template<class T>
+    class DenseMap
+    {
+      typedef std::map<long, T> SparseContainer;
+
+    public:
+      typedef long key_type;
+      typedef T mapped_type;
+      typedef std::pair<const long, T> value_type;
+
+      //! \brief The largest range of keys stored in the array.
+      static const size_t maxDenseSpan = 1 << 16;
+
+      class const_iterator
+      {
+      public:
+	typedef std::forward_iterator_tag iterator_category;
+	typedef typename DenseMap::value_type value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const value_type* pointer;
+	typedef value_type reference;
+
+	const_iterator(): _container(NULL), _index(0) {}
+
+	value_type operator*() const
+	{
+	  if (_container->_isSparse) return *_it;
+	  return value_type(_container->_offset + long(_index),
+			    _container->_data[_index]);
+	}
+
+	const_iterator& operator++()
+	{
+	  if (_container->_isSparse)
+	    ++_it;
+	  else
+	    {
+	      ++_index;
+	      skipUnused();
+	    }
+	  return *this;
+	}
+
+	const_iterator operator++(int)
+	{
+	  const_iterator retval(*this);
+	  ++(*this);
+	  return retval;
+	}
+
+	bool operator==(const const_iterator& o) const
+	{ return (_index == o._index) && (_it == o._it); }
+
+	bool operator!=(const const_iterator& o) const
+	{ return !(*this == o); }
+
+      private:
+	friend class DenseMap;
+
+	const_iterator(const DenseMap* container, size_t index,
+		       typename SparseContainer::const_iterator it):
+	  _container(container), _index(index), _it(it)
+	{ if (!_container->_isSparse) skipUnused(); }
+
+	void skipUnused()
+	{
+	  while ((_index < _container->_used.size()) && !_container->_used[_index])
+	    ++_index;
+	}
+
+	const DenseMap* _container;
+	size_t _index;
+	typename SparseContainer::const_iterator _it;
+      };
+
+      typedef const_iterator iterator;
+
+      DenseMap(): _offset(0), _count(0), _isSparse(false) {}
+
+      /*! \brief Access the value stored at a key, default
+       * constructing it if it does not exist.
+       */
+      T& operator[](const long& key)
+      {
+	if (_isSparse) return _sparse[key];
+
+	size_t index = key - _offset;
+	if (index >= _data.size())
+	  {
+	    if (!grow(key)) return _sparse[key];
+	    index = key - _offset;
+	  }
+
+	if (!_used[index])
+	  {
+	    _used[index] = true;
+	    ++_count;
+	  }
+
+	return _data[index];
+      }
+
+      const_iterator begin() const
+      { return const_iterator(this, 0, _sparse.begin()); }
+
+      const_iterator end() const
+      { return const_iterator(this, _isSparse ? 0 : _used.size(), _sparse.end()); }
+
+      //! \brief The number of keys which have been accessed.
+      size_t size() const { return _isSparse ? _sparse.size() : _count; }
+
+      bool empty() const { return !size(); }
+
+      void clear()
+      {
+	_offset = 0;
+	_count = 0;
+	_isSparse = false;
+	_data.clear();
+	_used.clear();
+	_sparse.clear();
+      }
+
+    private:
+      /*! \brief Enlarge the array to contain the key.
+       *
+       * The array is at least doubled in size to make the growth
+       * amortised constant time.
+       *
+       * \returns false if the keys are too spread out to be stored
+       * in the array, in which case the values have been moved into
+       * the sparse container.
+       */
+      bool grow(long key)
+      {
+	if (_data.empty())
+	  {
+	    _offset = key;
+	    _data.resize(1, T());
+	    _used.resize(1, false);
+	    return true;
+	  }
+
+	long low = _offset;
+	long high = _offset + long(_data.size());
+
+	if (key < low)
+	  {
+	    if (size_t(high - key) > maxDenseSpan) return makeSparse();
+	    low = std::min(key, std::max(low - long(_data.size()),
+					 high - long(maxDenseSpan)));
+	  }
+	else
+	  {
+	    if (size_t(key + 1 - low) > maxDenseSpan) return makeSparse();
+	    high = std::max(key + 1, std::min(high + long(_data.size()),
+					      low + long(maxDenseSpan)));
+	  }
+
+	std::vector<T> data(high - low, T());
+	std::vector<bool> used(high - low, false);
+	std::copy(_data.begin(), _data.end(), data.begin() + (_offset - low));
+	std::copy(_used.begin(), _used.end(), used.begin() + (_offset - low));
+
+	_data.swap(data);
+	_used.swap(used);
+	_offset = low;
+	return true;
+      }
+
+      bool makeSparse()
+      {
+	for (size_t i(0); i < _data.size(); ++i)
+	  if (_used[i])
+	    _sparse[_offset + long(i)] = _data[i];
+
+	_data.clear();
+	_used.clear();
+	_count = 0;
+	_isSparse = true;
+	return false;
+      }
+
+      long _offset;
+      size_t _count;
+      bool _isSparse;
+      std::vector<T> _data;
+      std::vector<bool> _used;
+      SparseContainer _sparse;
+    };
+  }
+}
@@ -17,7 +17,7 @@
 
 #pragma once
 #include <magnet/exception.hpp>
-#include <map>
+#include <magnet/containers/dense_map.hpp>
 #include <cmath>
 
 namespace magnet {
@@ -33,14 +33,16 @@ namespace magnet {
      * width (actually the inverse bin width \ref _invBinWidth), which
      * is used to map a floating point value to a bin.
      *
-     * This class is space efficient as it uses a map to store the
-     * allocated bins. A map (not a unordered_map) must be the
-     * default, as histogramming output assumes the values are sorted.
+     * The allocated bins are stored in a \ref DenseMap by default,
+     * which keeps them in an array while they are close together and
+     * falls back to a std::map if they are spread out. The container
+     * must be sorted (e.g., not an unordered_map), as histogramming
+     * output assumes the values are sorted.
      *
      * \tparam T The type stored by the FuzzyArray.
      * \tparam Container The underlying container used in the FuzzyArray.
      */
-    template<class T, bool shiftBin = true, class Container = std::map<long, T> >
+    template<class T, bool shiftBin = true, class Container = DenseMap<T> >
     class FuzzyArray : public Container
     {
     public:
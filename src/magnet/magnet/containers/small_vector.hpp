@@ -0,0 +1,153 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.marcusbannerman.co.uk/dynamo
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <boost/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace magnet {
+  namespace containers {
+    /*! \brief A vector which stores its first N elements inside the
+     * container itself.
+     *
+     * The elements are only moved to the heap once more than N are
+     * pushed in, so small containers never allocate. When on the
+     * heap, the capacity is doubled as it grows, as in a
+     * std::vector.
+     *
+     * The elements are only ever copy constructed, never assigned, so
+     * types with reference or const members (which cannot be stored
+     * in a std::vector) can be stored.
+     *
+     * \tparam T The type stored in the SmallVector.
+     * \tparam N The number of elements stored inside the container.
+     */
+    template<class T, size_t N>
+    class SmallVector
+    {
+    public:
+      typedef T value_type;
+      typedef T* iterator;
+      typedef const T* const_iterator;
+      typedef T& reference;
+      typedef const T& const_reference;
+      typedef size_t size_type;
+
+      SmallVector(): _data(inlineData()), _size(0), _capacity(N) {}
+
+      SmallVector(const SmallVector& other):
+	_data(inlineData()), _size(0), _capacity(N)
+      { append(other); }
+
+      ~SmallVector() { clear(); release(); }
+
+      SmallVector& operator=(const SmallVector& other)
+      {
+	if (this != &other)
+	  {
+	    clear();
+	    append(other);
+	  }
+	return *this;
+      }
+
+      void push_back(const T& val)
+      {
+	if (_size == _capacity) grow(2 * _capacity);
+	new (_data + _size) T(val);
+	++_size;
+      }
+
+      void clear()
+      {
+	for (size_t i(0); i < _size; ++i)
+	  _data[i].~T();
+	_size = 0;
+      }
+
+      size_t size() const { return _size; }
+      bool empty() const { return !_size; }
+
+      iterator begin() { return _data; }
+      const_iterator begin() const { return _data; }
+      iterator end() { return _data + _size; }
+      const_iterator end() const { return _data + _size; }
+
+      T& operator[](size_t i) { return _data[i]; }
+      const T& operator[](size_t i) const { return _data[i]; }
+
+      T& front() { return _data[0]; }
+      const T& front() const { return _data[0]; }
+      T& back() { return _data[_size - 1]; }
+      const T& back() const { return _data[_size - 1]; }
+
+    private:
+      T* inlineData() { return static_cast<T*>(_inline.address()); }
+
+      void append(const SmallVector& other)
+      {
+	if (_size + other._size > _capacity)
+	  grow(std::max(_size + other._size, 2 * _capacity));
+
+	for (size_t i(0); i < other._size; ++i)
+	  push_back(other._data[i]);
+      }
+
+      //! \brief Moves the elements into a heap array of the passed
+      //! capacity.
+      void grow(size_t capacity)
+      {
+	T* newData = static_cast<T*>(::operator new(capacity * sizeof(T)));
+
+	size_t i(0);
+	try {
+	  for (; i < _size; ++i)
+	    new (newData + i) T(_data[i]);
+	} catch (...) {
+	  while (i) newData[--i].~T();
+	  ::operator delete(newData);
+	  throw;
+	}
+
+	const size_t oldSize = _size;
+	clear();
+	release();
+
+	_data = newData;
+	_size = oldSize;
+	_capacity = capacity;
+      }
+
+      //! \brief Frees the heap array, if the elements are on the heap.
+      void release()
+      {
+	if (_data != inlineData())
+	  ::operator delete(_data);
+	_data = inlineData();
+	_capacity = N;
+      }
+
+      boost::aligned_storage<N * sizeof(T), boost::alignment_of<T>::value> _inline;
+      T* _data;
+      size_t _size;
+      size_t _capacity;
+    };
+  }
+}
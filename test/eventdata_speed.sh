@@ -0,0 +1,35 @@
+#!/bin/bash
+# Measures the event rate of systems where most of the work outside
+# the event prediction is passing the particle changes (NEventData)
+# to the output plugins: the heavy spheres system, and a hard sphere
+# fluid with an Andersen thermostat (which adds system events).
+dynamod="../bin/dynamod"
+dynarun="../bin/dynarun"
+
+NUMRUN=4
+NCOLL=1000000
+
+function testrun {
+    > speedvals
+    for i in $(seq 0 $NUMRUN); do
+	echo -n "Running test $i for $name...."
+	val=$($dynarun $config -c $NCOLL -o speedtest.xml.bz2 | grep "Avg Coll" | gawk '{print $4}')
+	echo $val
+	echo $val >> speedvals
+    done
+    echo $name $(cat speedvals | gawk 'BEGIN {sum=0; sqrsum=0} { sum += $1; sqrsum += $1*$1} END {print sum/NR, sqrt((sqrsum - sum * sum /NR) / NR)}') \
+	>> eventdata.dat
+}
+
+> eventdata.dat
+
+name="HeavySpheres"
+config="hvySpheres.xml.bz2"
+testrun
+
+name="ThermostattedHardSpheres"
+$dynamod -m 0 -T 1.0
+config="config.out.xml.bz2"
+testrun
+
+rm -f speedvals speedtest.xml.bz2 output.xml.bz2 config.out.xml.bz2
@@ -0,0 +1,71 @@
+#!/bin/bash
+#    DYNAMO:- Event driven molecular dynamics simulator
+#    http://www.marcusbannerman.co.uk/dynamo
+#    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+#
+#    This program is free software: you can redistribute it and/or
+#    modify it under the terms of the GNU General Public License
+#    version 3 as published by the Free Software Foundation.
+#
+#    This program is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#    GNU General Public License for more details.
+#
+#    You should have received a copy of the GNU General Public License
+#    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# Measures the jitter in the event rate of a large hard sphere
+# fluid. The wall clock time of every block of PRINT events is
+# recorded, and the mean, standard deviation and maximum block times
+# are reported for each dynarun passed on the command line, e.g.
+#
+#  ./stream_jitter.sh ../bin/dynarun ~/old_dynamo/bin/dynarun
+#
+# The default system is 4*63^3 = 1000188 particles, the number of
+# cells/particles, events and block size can be set through the C,
+# NCOLL and PRINT environment variables.
+
+Dynamod="../bin/dynamod"
+Awk="gawk"
+
+which $Awk > /dev/null || Awk="awk"
+
+C=${C:-63}
+NCOLL=${NCOLL:-50000000}
+PRINT=${PRINT:-100000}
+
+if [ $# -eq 0 ]; then
+    set -- "../bin/dynarun"
+fi
+
+if [ ! -x $Dynamod ]; then
+    echo "Could not find dynamod, have you built it?"
+    exit 1
+fi
+
+$Dynamod -m 0 -C $C -d 0.5 -o jitter.start.xml.bz2 > /dev/null
+
+for Dynarun in "$@"; do
+    if [ ! -x $Dynarun ]; then
+	echo "Could not find $Dynarun"
+	continue
+    fi
+
+    #Timestamp each periodic output line as it arrives
+    $Dynarun -c $NCOLL -p $PRINT jitter.start.xml.bz2 \
+	-o jitter.end.xml.bz2 --out-data-file jitter.output.xml.bz2 2>&1 \
+	| while read line; do
+	case "$line" in
+	    *NColls*) date +%s%N;;
+	esac
+    done \
+	| $Awk -v name=$Dynarun -v block=$PRINT \
+	'NR > 1 { dt = ($1 - last) / 1e9; sum += dt; sqrsum += dt * dt; n++; if (dt > max) max = dt }
+         { last = $1 }
+         END { mean = sum / n;
+               printf "%s: %d blocks of %d events, mean %g s, dev %g s, max %g s (%g x mean)\n",
+                      name, n, block, mean, sqrt(sqrsum / n - mean * mean), max, max / mean }'
+done
+
+rm -f jitter.start.xml.bz2 jitter.end.xml.bz2 jitter.output.xml.bz2
@@ -227,7 +227,7 @@ function cannon {
     
     rm tmp2.xml.bz2
     
-    $Dynarun -c 1000 tmp.xml.bz2 &> run.log
+    $Dynarun -c 1000 $3 tmp.xml.bz2 &> run.log
     
     if [ -e output.xml.bz2 ]; then
 	var=$(bzcat output.xml.bz2 | \
@@ -314,7 +314,7 @@ function HardSphereTest {
 
     $Dynamod -s 1 -m 0 &> run.log    
     $Dynarun -c 500000 config.out.xml.bz2 >> run.log 2>&1
-    $Dynarun -c 1000000 config.out.xml.bz2 >> run.log 2>&1
+    $Dynarun -c 1000000 $1 config.out.xml.bz2 >> run.log 2>&1
     
     if [ -e output.xml.bz2 ]; then
 	if [ $(bzcat output.xml.bz2 \
@@ -367,6 +367,40 @@ function SquareWellTest {
 	tmp.xml.bz2 run.log
 }
 
+function BinaryConfigTest {
+    > run.log
+
+    $Dynamod -s1 -m 1 -T 1 -o config.out.bin.xml.bz2 &> run.log    
+    $Dynarun -c 3000000 config.out.bin.xml.bz2 \
+	-o config.end.bin.xml.bz2 >> run.log 2>&1
+    $Dynarun -c 1000000 config.end.bin.xml.bz2 >> run.log 2>&1
+    
+    MFT="0.036"
+
+    if [ -e output.xml.bz2 ]; then
+	if [ $(bzcat output.xml.bz2 \
+	    | $Xml sel -t -v '/OutputData/Misc/totMeanFreeTime/@val' \
+	    | gawk '{var=($1-'$MFT')/'$MFT'; print ((var < 0.02) && (var > -0.02))}') != "1" ]; then
+	    echo "BinaryConfigTest -: FAILED, Measured MFT =" $(bzcat output.xml.bz2 \
+		| $Xml sel -t -v '/OutputData/Misc/totMeanFreeTime/@val') \
+		", expected MFT =" $MFT
+	    exit 1
+	else
+	    echo "BinaryConfigTest -: PASSED, Measured MFT =" $(bzcat output.xml.bz2 \
+		| $Xml sel -t -v '/OutputData/Misc/totMeanFreeTime/@val') \
+		", expected MFT =" $MFT
+	fi
+    else
+	echo "Error, no output.0.xml.bz2 in Binary Config test"
+	exit 1
+    fi
+    
+#Cleanup
+    rm -Rf config.end.xml.bz2 config.out.xml.bz2 output.xml.bz2 \
+	config.out.bin.xml.bz2 config.out.bin.dat \
+	config.end.bin.xml.bz2 config.end.bin.dat run.log
+}
+
 function BinarySphereTest {
     > run.log
 
@@ -585,20 +619,40 @@ echo "Testing basic system, zero + infinite time events, hard sphere, PBC, Neigh
 cannon "NeighbourList" "CBT"
 echo "Testing basic system, zero + infinite time events, hard sphere, PBC, Neighbour lists + scheduler, globals, boundedPQ"
 cannon "NeighbourList" "BoundedPQ"
+echo "Testing basic system, zero + infinite time events, hard sphere, PBC, Neighbour lists + scheduler, globals, compact boundedPQ"
+cannon "NeighbourList" "BoundedPQCompactMinMax3"
+echo "Testing basic system, zero + infinite time events, hard spheres, PBC, Dumb Scheduler, LadderQueue"
+cannon "Dumb" "LadderQueue"
+echo "Testing basic system, zero + infinite time events, hard sphere, PBC, Neighbour lists + scheduler, globals, LadderQueue"
+cannon "NeighbourList" "LadderQueue"
+echo "Testing basic system, zero + infinite time events, hard sphere, PBC, Neighbour lists + scheduler, globals, boundedPQ, threaded rebuild"
+cannon "NeighbourList" "BoundedPQ" "--scheduler-threads 2"
+echo "Testing basic system, zero + infinite time events, hard sphere, PBC, Neighbour lists + scheduler, globals, boundedPQ, Morton reordering"
+cannon "NeighbourList" "BoundedPQ" "--morton-reorder 0.3"
 
 echo ""
 echo "INTERACTIONS+Dynamod Systems"
 echo "Testing Hard Spheres, NeighbourLists and BoundedPQ's"
 HardSphereTest
+echo "Testing Hard Spheres, NeighbourLists, BoundedPQ's and PEL compaction"
+HardSphereTest "--scheduler-prune 0.05"
 echo "Testing binary hard spheres, NeighbourLists and BoundedPQ's"
 BinarySphereTest "Cells2"
 echo "Testing Square Wells, Thermostats, NeighbourLists and BoundedPQ's"
 SquareWellTest
+echo "Testing Square Wells stored in binary configuration files"
+BinaryConfigTest
 echo "Testing infinitely heavy particles"
 HeavySphereTest
 echo "Testing Lines, NeighbourLists and BoundedPQ's"
 HardLinesTest
 #linescannon "NeighbourList" "BoundedPQ"
+echo "Testing basic system, zero + infinite time events, hard spheres, PBC, Dumb Scheduler, LadderQueue"
+cannon "Dumb" "LadderQueue"
+echo "Testing basic system, zero + infinite time events, hard sphere, PBC, Neighbour lists + scheduler, globals, LadderQueue"
+cannon "NeighbourList" "LadderQueue"
+echo "Testing basic system, zero + infinite time events, hard sphere, PBC, Neighbour lists + scheduler, globals, boundedPQ, threaded rebuild"
+cannon "NeighbourList" "BoundedPQ" "--scheduler-threads 2"
 echo "Testing static spheres in gravity, NeighbourLists and BoundedPQ's"
 StaticSpheresTest
 
@@ -642,4 +696,6 @@ echo ""
 echo "THREADING TESTING"
 echo "Testing replica exchange with 3 threads"
 HS_replex_test "NeighbourList" "-N3"
+echo "Testing asynchronous replica exchange with 3 threads"
+HS_replex_test "NeighbourList" "-N3 --replex-swap-mode 5"
 
@@ -0,0 +1,24 @@
+#!/bin/bash
+# Measures the event rate of spheres falling through a funnel built
+# from a triangle mesh (packer mode 27), as the number of triangles in
+# the mesh is increased.
+dynamod="../bin/dynamod"
+dynarun="../bin/dynarun"
+
+NUMRUN=4
+NCOLL=1000000
+
+> trianglemesh.dat
+for strips in 12 24 48 96 192 384; do
+    > speedvals
+    $dynamod -m 27 --i2 $strips
+
+    for i in $(seq 0 $NUMRUN); do
+	echo -n "Running test $i for $strips triangle strips...."
+	val=$($dynarun config.out.xml.bz2 -c $NCOLL | grep "Avg Coll" | gawk '{print $4}')
+	echo $val
+	echo $val >> speedvals
+    done
+    echo $strips $(cat speedvals | gawk 'BEGIN {sum=0; sqrsum=0} { sum += $1; sqrsum += $1*$1} END {print sum/NR, sqrt((sqrsum - sum * sum /NR) / NR)}') \
+	>> trianglemesh.dat
+done